@@ -44,6 +44,12 @@ void add_d_arrays_to_first(int len, double* sum, const double* added)
         sum[i] += added[i];
 }
 
+void add_scaled_d_array_to_first(int len, double* sum, double v, const double* added)
+{
+    for(int i = 0; i < len; ++i)
+        sum[i] += v * added[i];
+}
+
 void sub_d_arrays_to_result(int len, const double* dec, const double* sub, double* dif)
 {
     for(int i = 0; i < len; ++i)
@@ -126,3 +132,237 @@ void round_d_array(int len, const double* Input, double* Output, int acc)
     for(int i = 0; i < len; ++i)
         Output[i] = roundf(Input[i] * d) / d;
 }
+
+// blocks of the pairwise summation are summed directly with
+// independent accumulators, so the compiler can vectorize them
+#define PAIRWISE_BLOCK_SIZE 128
+
+double pairwise_sum_d_array(int len, const double* a)
+{
+    if(len > PAIRWISE_BLOCK_SIZE)
+    {
+        int half = len / 2;
+        return pairwise_sum_d_array(half, a) + pairwise_sum_d_array(len - half, a + half);
+    }
+
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i = 0;
+    for(; i + 4 <= len; i += 4)
+    {
+        s0 += a[i];
+        s1 += a[i + 1];
+        s2 += a[i + 2];
+        s3 += a[i + 3];
+    }
+    for(; i < len; ++i)
+        s0 += a[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+// Kahan-Babuska (Neumaier) compensated summation
+double kahan_sum_d_array(int len, const double* a)
+{
+    double sum = 0;
+    double compensation = 0;
+    for(int i = 0; i < len; ++i)
+    {
+        double t = sum + a[i];
+        if(fabs(sum) >= fabs(a[i]))
+            compensation += (sum - t) + a[i];
+        else
+            compensation += (a[i] - t) + sum;
+        sum = t;
+    }
+    return sum + compensation;
+}
+
+double sum_d_array(int len, const double* a, enum summation method)
+{
+    if(method == SUMMATION_KAHAN)
+        return kahan_sum_d_array(len, a);
+    return pairwise_sum_d_array(len, a);
+}
+
+double abs_sum_d_array(int len, const double* a)
+{
+    double sum = 0;
+    for(int i = 0; i < len; ++i)
+        sum += fabs(a[i]);
+    return sum;
+}
+
+double squares_sum_d_array(int len, const double* a)
+{
+    double sum = 0;
+    for(int i = 0; i < len; ++i)
+        sum += a[i] * a[i];
+    return sum;
+}
+
+double dot_d_arrays(int len, const double* a, const double* b)
+{
+    double sum = 0;
+    for(int i = 0; i < len; ++i)
+        sum += a[i] * b[i];
+    return sum;
+}
+
+double abs_max_d_array(int len, const double* a)
+{
+    double max = 0;
+    for(int i = 0; i < len; ++i)
+        if(fabs(a[i]) > max)
+            max = fabs(a[i]);
+    return max;
+}
+
+// index of the first minimum, len > 0
+int argmin_d_array(int len, const double* a)
+{
+    int idx = 0;
+    for(int i = 1; i < len; ++i)
+        if(a[i] < a[idx])
+            idx = i;
+    return idx;
+}
+
+// index of the first maximum, len > 0
+int argmax_d_array(int len, const double* a)
+{
+    int idx = 0;
+    for(int i = 1; i < len; ++i)
+        if(a[i] > a[idx])
+            idx = i;
+    return idx;
+}
+
+double sigmoid(double x)
+{
+    if(x >= 0)
+        return 1 / (1 + exp(-x));
+    double e = exp(x);
+    return e / (1 + e);
+}
+
+// each function has its own loop without branches inside,
+// res can be equal to a
+void math_d_array(int len, const double* a, double* res, enum math_function f, const double* params)
+{
+    switch(f)
+    {
+    case MATH_EXP:
+        for(int i = 0; i < len; ++i)
+            res[i] = exp(a[i]);
+        break;
+    case MATH_LOG:
+        for(int i = 0; i < len; ++i)
+            res[i] = log(a[i]);
+        break;
+    case MATH_SQRT:
+        for(int i = 0; i < len; ++i)
+            res[i] = sqrt(a[i]);
+        break;
+    case MATH_SIN:
+        for(int i = 0; i < len; ++i)
+            res[i] = sin(a[i]);
+        break;
+    case MATH_COS:
+        for(int i = 0; i < len; ++i)
+            res[i] = cos(a[i]);
+        break;
+    case MATH_TANH:
+        for(int i = 0; i < len; ++i)
+            res[i] = tanh(a[i]);
+        break;
+    case MATH_SIGMOID:
+        for(int i = 0; i < len; ++i)
+            res[i] = sigmoid(a[i]);
+        break;
+    case MATH_POW:
+        if(params[0] == 2)
+            multiply_elems_d_array_to_result(len, a, a, res);
+        else
+            for(int i = 0; i < len; ++i)
+                res[i] = pow(a[i], params[0]);
+        break;
+    case MATH_CLAMP:
+        for(int i = 0; i < len; ++i)
+            res[i] = (a[i] < params[0]) ? params[0] : ((a[i] > params[1]) ? params[1] : a[i]);
+        break;
+    }
+}
+
+int math_function_arity(enum math_function f)
+{
+    if(f == MATH_POW)
+        return 1;
+    if(f == MATH_CLAMP)
+        return 2;
+    return 0;
+}
+
+// data   - array that will be shared between several owners
+// shared - owners of data, NULL if data has only one owner
+double* share_d_array(double* data, struct shared_d_array** shared)
+{
+    if(*shared == NULL)
+    {
+        *shared = malloc(sizeof(struct shared_d_array));
+        (*shared)->refs = 1;
+        (*shared)->release = NULL;
+        (*shared)->context = NULL;
+        (*shared)->writable = true;
+    }
+    ++(*shared)->refs;
+    return data;
+}
+
+// returns the array that belongs only to the caller:
+// data itself if it is not shared, otherwise a copy of data
+double* unshare_d_array(int len, double* data, struct shared_d_array** shared)
+{
+    struct shared_d_array* s = *shared;
+    if(s == NULL)
+        return data;
+
+    if(s->refs == 1 && (s->release == NULL || s->writable))
+    {
+        if(s->release == NULL)
+        {
+            free(s);
+            *shared = NULL;
+        }
+        return data;
+    }
+
+    double* result = malloc(len * sizeof(double));
+    copy_d_array(len, data, result);
+    release_d_array(data, s);
+    *shared = NULL;
+    return result;
+}
+
+void release_d_array(double* data, struct shared_d_array* shared)
+{
+    if(shared == NULL)
+    {
+        free(data);
+        return;
+    }
+
+    if(--shared->refs > 0)
+        return;
+
+    if(shared->release == NULL)
+        free(data);
+    else
+        shared->release(shared, data);
+    free(shared);
+}
+
+// true if the elements live in memory of a file or another object,
+// so writes to them are visible outside
+bool d_array_external(const struct shared_d_array* shared)
+{
+    return shared != NULL && shared->release != NULL;
+}
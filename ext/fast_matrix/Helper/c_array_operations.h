@@ -10,6 +10,7 @@ void multiply_d_array_to_result(int len, const double* a, double v, double* res)
 void copy_d_array(int len, const double* input, double* output);
 void add_d_arrays_to_result(int len, const double* a1, const double* a2, double* result);
 void add_d_arrays_to_first(int len, double* sum, const double* added);
+void add_scaled_d_array_to_first(int len, double* sum, double v, const double* added);
 void sub_d_arrays_to_result(int len, const double* dec, const double* sub, double* dif);
 void sub_d_arrays_to_first(int len, double* dif, const double* sub);
 bool equal_d_arrays(int len, const double* A, const double* B);
@@ -22,4 +23,54 @@ bool zero_d_array(int len, const double* A);
 void swap_d_arrays(int len, double* A, double* B);
 void round_d_array(int len, const double* Input, double* Output, int acc);
 
+enum summation
+{
+    SUMMATION_PAIRWISE,
+    SUMMATION_KAHAN,
+};
+
+double pairwise_sum_d_array(int len, const double* a);
+double kahan_sum_d_array(int len, const double* a);
+double sum_d_array(int len, const double* a, enum summation method);
+double abs_sum_d_array(int len, const double* a);
+double squares_sum_d_array(int len, const double* a);
+double dot_d_arrays(int len, const double* a, const double* b);
+double abs_max_d_array(int len, const double* a);
+int argmin_d_array(int len, const double* a);
+int argmax_d_array(int len, const double* a);
+
+enum math_function
+{
+    MATH_EXP,
+    MATH_LOG,
+    MATH_SQRT,
+    MATH_SIN,
+    MATH_COS,
+    MATH_TANH,
+    MATH_SIGMOID,
+    MATH_POW,
+    MATH_CLAMP,
+};
+
+// params are the exponent for MATH_POW, minimum and maximum for MATH_CLAMP
+void math_d_array(int len, const double* a, double* res, enum math_function f, const double* params);
+int math_function_arity(enum math_function f);
+
+// elements shared by several matrices or vectors
+struct shared_d_array
+{
+    int refs;
+    // frees elements that were not allocated by malloc, NULL otherwise
+    void (*release)(struct shared_d_array* shared, double* data);
+    // data for release
+    void* context;
+    // false if the elements cannot be written, then even the last owner copies them
+    bool writable;
+};
+
+double* share_d_array(double* data, struct shared_d_array** shared);
+double* unshare_d_array(int len, double* data, struct shared_d_array** shared);
+void release_d_array(double* data, struct shared_d_array* shared);
+bool d_array_external(const struct shared_d_array* shared);
+
 #endif  /*C_ARRAY_OPERATIONS*/
@@ -23,6 +23,65 @@ int raise_rb_value_to_int(VALUE v)
     return 0;
 }
 
+enum summation raise_rb_value_to_summation(int argc, VALUE* argv)
+{
+    if(argc > 1)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    if(argc == 0 || argv[0] == ID2SYM(rb_intern("pairwise")))
+        return SUMMATION_PAIRWISE;
+    if(argv[0] == ID2SYM(rb_intern("kahan")))
+        return SUMMATION_KAHAN;
+    rb_raise(fm_eTypeError, "Unknown summation method");
+    return SUMMATION_PAIRWISE;
+}
+
+double raise_rb_value_to_tolerance(int argc, VALUE* argv)
+{
+    if(argc > 1)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    if(argc == 0)
+        return 0;
+    double tolerance = raise_rb_value_to_double(argv[0]);
+    if(tolerance < 0)
+        rb_raise(fm_eIndexError, "Tolerance cannot be negative");
+    return tolerance;
+}
+
+void raise_get_options(int* argc, const VALUE* argv, int count, const char* const* names, VALUE* values)
+{
+    for(int i = 0; i < count; ++i)
+        values[i] = Qundef;
+    if(*argc == 0 || !RB_TYPE_P(argv[*argc - 1], T_HASH))
+        return;
+
+    VALUE options = argv[--*argc];
+    size_t found = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        values[i] = rb_hash_lookup2(options, ID2SYM(rb_intern(names[i])), Qundef);
+        if(values[i] != Qundef)
+            ++found;
+    }
+    if(found != RHASH_SIZE(options))
+        rb_raise(fm_eTypeError, "Unknown option");
+}
+
+VALUE raise_get_out_option(int* argc, const VALUE* argv)
+{
+    const char* const names[] = {"out"};
+    VALUE out;
+    raise_get_options(argc, argv, 1, names, &out);
+    return (out == Qundef) ? Qnil : out;
+}
+
+void raise_math_arguments(int argc, const VALUE* argv, enum math_function f, double* params)
+{
+    if(argc != math_function_arity(f))
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    for(int i = 0; i < argc; ++i)
+        params[i] = raise_rb_value_to_double(argv[i]);
+}
+
 void raise_check_range(int v, int min, int max)
 {
     if(v < min || v >= max)
@@ -31,7 +90,7 @@ void raise_check_range(int v, int min, int max)
 
 void raise_check_rbasic(VALUE v, VALUE rBasic, const char* rbasic_name)
 {
-    if(RBASIC_CLASS(v) != rBasic)
+    if(RB_SPECIAL_CONST_P(v) || RBASIC_CLASS(v) != rBasic)
         rb_raise(fm_eTypeError, "Expected class %s", rbasic_name);
 }
 
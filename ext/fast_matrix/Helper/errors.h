@@ -2,6 +2,7 @@
 #define FAST_MATRIX_ERRORS_H 1
 
 #include "ruby.h"
+#include "Helper/c_array_operations.h"
 
 extern VALUE fm_eTypeError;
 extern VALUE fm_eIndexError;
@@ -11,6 +12,17 @@ extern VALUE fm_eFrozenError;
 double raise_rb_value_to_double(VALUE v);
 //  convert ruby value to int or raise an error if this is not possible
 int raise_rb_value_to_int(VALUE v);
+//  convert optional ruby symbol :pairwise or :kahan to the method of summation
+enum summation raise_rb_value_to_summation(int argc, VALUE* argv);
+//  convert optional ruby value to the nonnegative tolerance of comparisons, 0 if it is not given
+double raise_rb_value_to_tolerance(int argc, VALUE* argv);
+//  remove the trailing Hash of options from the arguments,
+//  values[i] is the option names[i] or Qundef if it is not given
+void raise_get_options(int* argc, const VALUE* argv, int count, const char* const* names, VALUE* values);
+//  remove the trailing out: option from the arguments and return it, Qnil if it is not given
+VALUE raise_get_out_option(int* argc, const VALUE* argv);
+//  convert the arguments of the element-wise function to params
+void raise_math_arguments(int argc, const VALUE* argv, enum math_function f, double* params);
 //  check if the value is in range and raise an error if not
 void raise_check_range(int v, int min, int max);
 //  check if the basic class of value is rBasic and raise an error if not
@@ -0,0 +1,174 @@
+#include "Helper/mapped_file.h"
+
+#ifdef HAVE_SYS_MMAN_H
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Helper/errors.h"
+#include "Helper/serialization.h"
+
+struct mapped_file
+{
+    void* addr;
+    size_t length;
+    // true if the memory is not backed by a file
+    bool anonymous;
+};
+
+void release_mapped_file(struct shared_d_array* shared, double* data)
+{
+    struct mapped_file* file = shared->context;
+    munmap(file->addr, file->length);
+    free(file);
+}
+
+bool d_array_in_shared_memory(const struct shared_d_array* shared)
+{
+    return shared != NULL && shared->release == release_mapped_file
+        && ((struct mapped_file*)shared->context)->anonymous;
+}
+
+//  the counter of owners stays in the private memory of every process,
+//  so the shared pages are never written after the move
+double* move_d_array_to_shared_memory(int len, double* data, struct shared_d_array** shared)
+{
+    if(d_array_in_shared_memory(*shared))
+        return data;
+
+    size_t length = len * sizeof(double);
+    void* addr = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(addr == MAP_FAILED)
+        rb_sys_fail("mmap");
+    copy_d_array(len, data, addr);
+    mprotect(addr, length, PROT_READ);
+    release_d_array(data, *shared);
+
+    struct mapped_file* file = malloc(sizeof(struct mapped_file));
+    file->addr = addr;
+    file->length = length;
+    file->anonymous = true;
+
+    *shared = malloc(sizeof(struct shared_d_array));
+    (*shared)->refs = 1;
+    (*shared)->release = release_mapped_file;
+    (*shared)->context = file;
+    (*shared)->writable = false;
+    return addr;
+}
+
+#endif /* HAVE_SYS_MMAN_H */
+
+#ifdef FAST_MATRIX_MAPPED_FILE
+
+enum map_mode raise_rb_value_to_map_mode(VALUE v)
+{
+    if(v == ID2SYM(rb_intern("read")))
+        return MAP_MODE_READ;
+    if(v == ID2SYM(rb_intern("copy")))
+        return MAP_MODE_COPY;
+    if(v == ID2SYM(rb_intern("write")))
+        return MAP_MODE_WRITE;
+    rb_raise(fm_eTypeError, "Mode must be :read, :copy or :write");
+}
+
+//  check the header of the mapped file and compare its sizes with the given ones
+void raise_check_mapped_header(void* addr, size_t length, const char* signature, int ndim, int* shape)
+{
+    int file_shape[2];
+    long len = 1;
+    bool valid = read_binary_header(addr, length, signature, ndim, file_shape);
+    for(int i = 0; valid && i < ndim; ++i)
+        len *= file_shape[i];
+
+    if(!valid || length < binary_header_size(ndim) + len * sizeof(double))
+    {
+        munmap(addr, length);
+        rb_raise(fm_eTypeError, "Invalid binary file");
+    }
+
+    for(int i = 0; i < ndim; ++i)
+    {
+        if(shape[i] > 0 && shape[i] != file_shape[i])
+        {
+            munmap(addr, length);
+            rb_raise(fm_eIndexError, "Sizes differ from the file");
+        }
+        shape[i] = file_shape[i];
+    }
+}
+
+double* raise_map_d_array(VALUE path, const char* signature, int ndim, int* shape, enum map_mode mode, struct shared_d_array** shared)
+{
+    const char* name = StringValueCStr(path);
+    int fd = open(name, (mode == MAP_MODE_WRITE) ? O_RDWR | O_CREAT : O_RDONLY, 0644);
+    if(fd < 0)
+        rb_sys_fail_str(path);
+
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+        close(fd);
+        rb_sys_fail_str(path);
+    }
+
+    long header = binary_header_size(ndim);
+    long len = 1;
+    for(int i = 0; i < ndim; ++i)
+        len *= shape[i];
+
+    size_t length = st.st_size;
+    bool create = length == 0 && mode == MAP_MODE_WRITE;
+    if(create)
+    {
+        if(len <= 0)
+        {
+            close(fd);
+            rb_raise(fm_eIndexError, "Sizes are required for a new file");
+        }
+        if(!d_array_shape_fits(ndim, shape))
+        {
+            close(fd);
+            rb_raise(fm_eIndexError, "Size is too big");
+        }
+        length = header + len * sizeof(double);
+        if(ftruncate(fd, length) != 0)
+        {
+            close(fd);
+            rb_sys_fail_str(path);
+        }
+    }
+    else if(length == 0)
+    {
+        close(fd);
+        rb_raise(fm_eTypeError, "Invalid binary file");
+    }
+
+    int prot = (mode == MAP_MODE_READ) ? PROT_READ : PROT_READ | PROT_WRITE;
+    int flags = (mode == MAP_MODE_COPY) ? MAP_PRIVATE : MAP_SHARED;
+    void* addr = mmap(NULL, length, prot, flags, fd, 0);
+    close(fd);
+    if(addr == MAP_FAILED)
+        rb_sys_fail_str(path);
+
+    if(create)
+        write_binary_header(addr, signature, ndim, shape);
+    else
+        raise_check_mapped_header(addr, length, signature, ndim, shape);
+
+    struct mapped_file* file = malloc(sizeof(struct mapped_file));
+    file->addr = addr;
+    file->length = length;
+    file->anonymous = false;
+
+    *shared = malloc(sizeof(struct shared_d_array));
+    (*shared)->refs = 1;
+    (*shared)->release = release_mapped_file;
+    (*shared)->context = file;
+    (*shared)->writable = mode != MAP_MODE_READ;
+    return (double*)((char*)addr + header);
+}
+
+#endif /* FAST_MATRIX_MAPPED_FILE */
@@ -0,0 +1,34 @@
+#ifndef FAST_MATRIX_MAPPED_FILE_H
+#define FAST_MATRIX_MAPPED_FILE_H 1
+
+#include "ruby.h"
+#include "Helper/c_array_operations.h"
+
+#if defined(HAVE_SYS_MMAN_H) && !defined(WORDS_BIGENDIAN)
+#define FAST_MATRIX_MAPPED_FILE 1
+
+enum map_mode
+{
+    MAP_MODE_READ,
+    MAP_MODE_COPY,
+    MAP_MODE_WRITE,
+};
+
+//  convert ruby symbol to the mode or raise an error if this is not possible
+enum map_mode raise_rb_value_to_map_mode(VALUE v);
+//  map the file with the binary form of ndim <= 2 dimensional elements and return them,
+//  zero sizes in shape are read from the file, the file is created for MAP_MODE_WRITE if needed
+double* raise_map_d_array(VALUE path, const char* signature, int ndim, int* shape, enum map_mode mode, struct shared_d_array** shared);
+
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+#define FAST_MATRIX_SHARED_MEMORY 1
+
+//  move len elements to read-only anonymous memory which is shared with forked processes
+double* move_d_array_to_shared_memory(int len, double* data, struct shared_d_array** shared);
+bool d_array_in_shared_memory(const struct shared_d_array* shared);
+
+#endif
+
+#endif /* FAST_MATRIX_MAPPED_FILE_H */
@@ -0,0 +1,202 @@
+#include "Helper/memory_view.h"
+#include "Helper/errors.h"
+
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+
+#ifdef WORDS_BIGENDIAN
+#define NATIVE_LITTLE_ENDIAN false
+#else
+#define NATIVE_LITTLE_ENDIAN true
+#endif
+
+//  the elements of a wrapped view belong to the exporter, release of the view
+//  is left to the finalizer of the token that the owners mark
+void release_wrapped_memory_view(struct shared_d_array* shared, double* data)
+{
+}
+
+void mark_shared_d_array(struct shared_d_array* shared)
+{
+    if(shared != NULL && shared->release == release_wrapped_memory_view)
+        rb_gc_mark((VALUE)shared->context);
+}
+
+bool export_d_array_memory_view(rb_memory_view_t* view, VALUE obj, double* data, int ndim, const int* shape, bool readonly)
+{
+    //  shape and strides are released together with the view
+    ssize_t* sizes = malloc(2 * ndim * sizeof(ssize_t));
+    ssize_t count = 1;
+    for(int i = 0; i < ndim; ++i)
+    {
+        sizes[i] = shape[i];
+        count *= shape[i];
+    }
+    rb_memory_view_fill_contiguous_strides(ndim, sizeof(double), sizes, true, sizes + ndim);
+
+    view->obj = obj;
+    view->data = data;
+    view->byte_size = count * sizeof(double);
+    view->readonly = readonly;
+    view->format = "d";
+    view->item_size = sizeof(double);
+    view->item_desc.components = NULL;
+    view->item_desc.length = 0;
+    view->ndim = ndim;
+    view->shape = sizes;
+    view->strides = sizes + ndim;
+    view->sub_offsets = NULL;
+    view->private_data = sizes;
+    return true;
+}
+
+bool release_d_array_memory_view(rb_memory_view_t* view)
+{
+    free(view->private_data);
+    return true;
+}
+
+//  check that the elements of the view are native doubles
+bool memory_view_of_doubles(const rb_memory_view_t* view)
+{
+    if(view->format == NULL)
+        return view->item_size == 1 && view->byte_size % sizeof(double) == 0;
+
+    rb_memory_view_item_component_t* members;
+    size_t n_members;
+    ssize_t size = rb_memory_view_parse_item_format(view->format, &members, &n_members, NULL);
+    if(size < 0)
+        return false;
+
+    bool result = size == sizeof(double) && n_members == 1 && members[0].repeat == 1
+        && (members[0].format == 'd' || members[0].format == 'E' || members[0].format == 'G')
+        && members[0].little_endian_p == NATIVE_LITTLE_ENDIAN;
+    xfree(members);
+    return result;
+}
+
+//  views without strides are always contiguous
+bool memory_view_contiguous(const rb_memory_view_t* view)
+{
+    return view->strides == NULL || rb_memory_view_is_row_major_contiguous(view);
+}
+
+void raise_get_d_array_memory_view(VALUE obj, rb_memory_view_t* view, bool wrap, int* count)
+{
+    int flags = RUBY_MEMORY_VIEW_FORMAT;
+    flags |= wrap ? RUBY_MEMORY_VIEW_ROW_MAJOR : RUBY_MEMORY_VIEW_STRIDES;
+    if(!rb_memory_view_get(obj, view, flags))
+        rb_raise(fm_eTypeError, "Object does not export memory view");
+
+    if(!memory_view_of_doubles(view) || (wrap && !memory_view_contiguous(view)))
+    {
+        rb_memory_view_release(view);
+        rb_raise(fm_eTypeError, "Expected contiguous memory view of doubles");
+    }
+
+    if(view->shape == NULL)
+        *count = view->byte_size / sizeof(double);
+    else
+    {
+        *count = 1;
+        for(int i = 0; i < view->ndim; ++i)
+            *count *= view->shape[i];
+    }
+}
+
+void copy_d_array_from_memory_view(int count, const rb_memory_view_t* view, double* C)
+{
+    if(memory_view_contiguous(view))
+    {
+        memcpy(C, view->data, count * sizeof(double));
+        return;
+    }
+
+    //  walk over the strided view, the last index changes first
+    int ndim = view->ndim;
+    ssize_t* index = calloc(ndim, sizeof(ssize_t));
+    for(int i = 0; i < count; ++i)
+    {
+        const char* p = view->data;
+        for(int d = 0; d < ndim; ++d)
+            p += index[d] * view->strides[d];
+        memcpy(C + i, p, sizeof(double));
+
+        for(int d = ndim - 1; d >= 0; --d)
+        {
+            if(++index[d] < view->shape[d])
+                break;
+            index[d] = 0;
+        }
+    }
+    free(index);
+}
+
+struct wrapped_memory_view
+{
+    rb_memory_view_t view;
+    bool released;
+};
+
+void wrapped_memory_view_mark(void* data)
+{
+    struct wrapped_memory_view* w = data;
+    if(!w->released)
+        rb_gc_mark(w->view.obj);
+}
+
+size_t wrapped_memory_view_size(const void* data)
+{
+    return sizeof(struct wrapped_memory_view);
+}
+
+const rb_data_type_t wrapped_memory_view_type =
+{
+    .wrap_struct_name = "wrapped_memory_view",
+    .function =
+    {
+        .dmark = wrapped_memory_view_mark,
+        .dfree = RUBY_DEFAULT_FREE,
+        .dsize = wrapped_memory_view_size,
+    },
+    .data = NULL,
+    .flags = RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+VALUE release_wrapped_memory_view_finalizer(RB_BLOCK_CALL_FUNC_ARGLIST(id, holder))
+{
+    struct wrapped_memory_view* w = DATA_PTR(holder);
+    if(!w->released)
+    {
+        rb_memory_view_release(&w->view);
+        w->released = true;
+    }
+    return Qnil;
+}
+
+//  owners mark a token object, its finalizer releases the view after the last owner
+//  is swept, the finalizer holds the view with the exporter, so both outlive the sweep
+struct shared_d_array* wrap_d_array_memory_view(const rb_memory_view_t* view)
+{
+    struct wrapped_memory_view* w;
+    VALUE holder = TypedData_Make_Struct(rb_cObject, struct wrapped_memory_view, &wrapped_memory_view_type, w);
+    w->view = *view;
+    w->released = false;
+
+    VALUE token = rb_obj_alloc(rb_cObject);
+    rb_define_finalizer(token, rb_proc_new(release_wrapped_memory_view_finalizer, holder));
+
+    struct shared_d_array* shared = malloc(sizeof(struct shared_d_array));
+    shared->refs = 1;
+    shared->release = release_wrapped_memory_view;
+    shared->context = (void*)token;
+    shared->writable = !view->readonly;
+    return shared;
+}
+
+#else
+
+void mark_shared_d_array(struct shared_d_array* shared)
+{
+}
+
+#endif /* HAVE_RUBY_MEMORY_VIEW_H */
@@ -0,0 +1,25 @@
+#ifndef FAST_MATRIX_MEMORY_VIEW_H
+#define FAST_MATRIX_MEMORY_VIEW_H 1
+
+#include "ruby.h"
+#include "Helper/c_array_operations.h"
+
+//  mark the object that owns the shared elements, if any
+void mark_shared_d_array(struct shared_d_array* shared);
+
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+#include "ruby/memory_view.h"
+
+//  fill the view of row-major doubles with the given shape
+bool export_d_array_memory_view(rb_memory_view_t* view, VALUE obj, double* data, int ndim, const int* shape, bool readonly);
+bool release_d_array_memory_view(rb_memory_view_t* view);
+//  get the view of doubles from obj and count its elements or raise an error if this is not possible
+void raise_get_d_array_memory_view(VALUE obj, rb_memory_view_t* view, bool wrap, int* count);
+//  copy count elements of the view to C in row-major order
+void copy_d_array_from_memory_view(int count, const rb_memory_view_t* view, double* C);
+//  shared elements which release the view after the last owner
+struct shared_d_array* wrap_d_array_memory_view(const rb_memory_view_t* view);
+
+#endif /* HAVE_RUBY_MEMORY_VIEW_H */
+
+#endif /* FAST_MATRIX_MEMORY_VIEW_H */
@@ -0,0 +1,269 @@
+#include "Helper/serialization.h"
+#include "Helper/errors.h"
+
+#define BINARY_SIGNATURE_SIZE 4
+#define NPY_MAGIC "\x93NUMPY"
+#define NPY_MAGIC_SIZE 6
+#define NPY_ALIGNMENT 64
+#define NPY_MAX_HEADER 4096
+
+//  copy len doubles to little-endian bytes and back
+void d_array_to_le(int len, const double* A, char* out)
+{
+#ifdef WORDS_BIGENDIAN
+    for(int i = 0; i < len; ++i)
+    {
+        const char* p = (const char*)(A + i);
+        for(int j = 0; j < 8; ++j)
+            out[8 * i + j] = p[7 - j];
+    }
+#else
+    memcpy(out, A, len * sizeof(double));
+#endif
+}
+
+void d_array_from_le(int len, const char* in, double* A)
+{
+#ifdef WORDS_BIGENDIAN
+    //  in and A may be the same memory
+    for(int i = 0; i < len; ++i)
+    {
+        double v;
+        char* p = (char*)&v;
+        for(int j = 0; j < 8; ++j)
+            p[j] = in[8 * i + 7 - j];
+        A[i] = v;
+    }
+#else
+    memcpy(A, in, len * sizeof(double));
+#endif
+}
+
+void int_to_le(int v, char* out)
+{
+    unsigned int u = v;
+    for(int i = 0; i < 4; ++i)
+        out[i] = (u >> (8 * i)) & 0xff;
+}
+
+int int_from_le(const char* in)
+{
+    unsigned int u = 0;
+    for(int i = 0; i < 4; ++i)
+        u |= (unsigned int)(unsigned char)in[i] << (8 * i);
+    return u;
+}
+
+//  the product of the sizes fits the int length of arrays of doubles
+bool d_array_shape_fits(int ndim, const int* shape)
+{
+    long len = 1;
+    for(int i = 0; i < ndim; ++i)
+    {
+        if(shape[i] > INT_MAX / (long)sizeof(double) / len)
+            return false;
+        len *= shape[i];
+    }
+    return true;
+}
+
+//  elements are aligned, so the binary form can be mapped to memory
+long binary_header_size(int ndim)
+{
+    long size = BINARY_SIGNATURE_SIZE + 4 * ndim;
+    return (size + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+}
+
+void write_binary_header(char* p, const char* signature, int ndim, const int* shape)
+{
+    memset(p, 0, binary_header_size(ndim));
+    memcpy(p, signature, BINARY_SIGNATURE_SIZE);
+    for(int i = 0; i < ndim; ++i)
+        int_to_le(shape[i], p + BINARY_SIGNATURE_SIZE + 4 * i);
+}
+
+bool read_binary_header(const char* p, long size, const char* signature, int ndim, int* shape)
+{
+    if(size < binary_header_size(ndim) || memcmp(p, signature, BINARY_SIGNATURE_SIZE) != 0)
+        return false;
+
+    for(int i = 0; i < ndim; ++i)
+    {
+        shape[i] = int_from_le(p + BINARY_SIGNATURE_SIZE + 4 * i);
+        if(shape[i] <= 0)
+            return false;
+    }
+    return d_array_shape_fits(ndim, shape);
+}
+
+VALUE d_array_to_binary(const char* signature, int ndim, const int* shape, const double* data)
+{
+    int len = 1;
+    for(int i = 0; i < ndim; ++i)
+        len *= shape[i];
+
+    long header = binary_header_size(ndim);
+    VALUE result = rb_str_new(NULL, header + len * sizeof(double));
+    char* p = RSTRING_PTR(result);
+
+    write_binary_header(p, signature, ndim, shape);
+    d_array_to_le(len, data, p + header);
+    return result;
+}
+
+void raise_check_binary(VALUE str, const char* signature, int ndim, int* shape)
+{
+    Check_Type(str, T_STRING);
+    long size = RSTRING_LEN(str);
+
+    if(!read_binary_header(RSTRING_PTR(str), size, signature, ndim, shape))
+        rb_raise(fm_eTypeError, "Invalid binary data");
+
+    long len = 1;
+    for(int i = 0; i < ndim; ++i)
+        len *= shape[i];
+
+    if(size != binary_header_size(ndim) + len * (long)sizeof(double))
+        rb_raise(fm_eTypeError, "Invalid binary data");
+}
+
+void d_array_from_binary(VALUE str, int ndim, double* data)
+{
+    long header = binary_header_size(ndim);
+    long len = (RSTRING_LEN(str) - header) / sizeof(double);
+    d_array_from_le(len, RSTRING_PTR(str) + header, data);
+}
+
+void raise_save_npy(VALUE path, int ndim, const int* shape, const double* data)
+{
+    char dict[NPY_MAX_HEADER];
+    int len = shape[0];
+    int written;
+    if(ndim == 1)
+        written = snprintf(dict, NPY_MAX_HEADER, "{'descr': '<f8', 'fortran_order': False, 'shape': (%d,), }", shape[0]);
+    else
+    {
+        len *= shape[1];
+        written = snprintf(dict, NPY_MAX_HEADER, "{'descr': '<f8', 'fortran_order': False, 'shape': (%d, %d), }", shape[0], shape[1]);
+    }
+
+    //  magic, version, header length, dictionary, padding and '\n'
+    int header = NPY_MAGIC_SIZE + 4 + written + 1;
+    int padding = (NPY_ALIGNMENT - header % NPY_ALIGNMENT) % NPY_ALIGNMENT;
+    memset(dict + written, ' ', padding);
+    dict[written + padding] = '\n';
+    int dict_len = written + padding + 1;
+
+    char prefix[NPY_MAGIC_SIZE + 4];
+    memcpy(prefix, NPY_MAGIC, NPY_MAGIC_SIZE);
+    prefix[NPY_MAGIC_SIZE] = 1;
+    prefix[NPY_MAGIC_SIZE + 1] = 0;
+    prefix[NPY_MAGIC_SIZE + 2] = dict_len & 0xff;
+    prefix[NPY_MAGIC_SIZE + 3] = (dict_len >> 8) & 0xff;
+
+    FILE* file = fopen(StringValueCStr(path), "wb");
+    if(file == NULL)
+        rb_sys_fail_str(path);
+
+    bool ok = fwrite(prefix, 1, sizeof(prefix), file) == sizeof(prefix)
+        && fwrite(dict, 1, dict_len, file) == (size_t)dict_len;
+#ifdef WORDS_BIGENDIAN
+    char buffer[8 * 512];
+    for(int i = 0; ok && i < len; i += 512)
+    {
+        int count = (len - i < 512) ? len - i : 512;
+        d_array_to_le(count, data + i, buffer);
+        ok = fwrite(buffer, sizeof(double), count, file) == (size_t)count;
+    }
+#else
+    ok = ok && fwrite(data, sizeof(double), len, file) == (size_t)len;
+#endif
+
+    if(fclose(file) != 0 || !ok)
+        rb_sys_fail_str(path);
+}
+
+//  value of the key in the header dictionary
+const char* npy_header_value(const char* dict, const char* key)
+{
+    const char* p = strstr(dict, key);
+    if(p == NULL)
+        return NULL;
+    p = strchr(p + strlen(key), ':');
+    if(p == NULL)
+        return NULL;
+    ++p;
+    while(*p == ' ')
+        ++p;
+    return p;
+}
+
+bool npy_parse_header(const char* dict, int* ndim, int* shape, bool* fortran_order)
+{
+    const char* descr = npy_header_value(dict, "'descr'");
+    const char* order = npy_header_value(dict, "'fortran_order'");
+    const char* sizes = npy_header_value(dict, "'shape'");
+    if(descr == NULL || order == NULL || sizes == NULL)
+        return false;
+
+    if(strncmp(descr, "'<f8'", 5) != 0)
+        return false;
+    *fortran_order = strncmp(order, "True", 4) == 0;
+
+    long a, b;
+    char c;
+    if(sscanf(sizes, "(%ld, %ld%c", &a, &b, &c) == 3 && c == ')')
+        *ndim = 2;
+    else if(sscanf(sizes, "(%ld,%c", &a, &c) == 2 && c == ')')
+        *ndim = 1;
+    else
+        return false;
+
+    if(a <= 0 || a > INT_MAX || (*ndim == 2 && (b <= 0 || b > INT_MAX)))
+        return false;
+    shape[0] = a;
+    shape[1] = (*ndim == 2) ? b : 1;
+    return d_array_shape_fits(2, shape);
+}
+
+FILE* raise_open_npy(VALUE path, int* ndim, int* shape, bool* fortran_order)
+{
+    FILE* file = fopen(StringValueCStr(path), "rb");
+    if(file == NULL)
+        rb_sys_fail_str(path);
+
+    char prefix[NPY_MAGIC_SIZE + 4];
+    char dict[NPY_MAX_HEADER + 1];
+    bool ok = fread(prefix, 1, sizeof(prefix), file) == sizeof(prefix)
+        && memcmp(prefix, NPY_MAGIC, NPY_MAGIC_SIZE) == 0 && prefix[NPY_MAGIC_SIZE] == 1;
+
+    int dict_len = 0;
+    if(ok)
+    {
+        dict_len = (unsigned char)prefix[NPY_MAGIC_SIZE + 2] | ((unsigned char)prefix[NPY_MAGIC_SIZE + 3] << 8);
+        ok = dict_len <= NPY_MAX_HEADER && fread(dict, 1, dict_len, file) == (size_t)dict_len;
+    }
+    if(ok)
+    {
+        dict[dict_len] = '\0';
+        ok = npy_parse_header(dict, ndim, shape, fortran_order);
+    }
+
+    if(!ok)
+    {
+        fclose(file);
+        rb_raise(fm_eTypeError, "Invalid .npy file");
+    }
+    return file;
+}
+
+void raise_read_npy(FILE* file, VALUE path, int len, double* data)
+{
+    bool ok = fread(data, sizeof(double), len, file) == (size_t)len;
+    fclose(file);
+    if(!ok)
+        rb_raise(fm_eTypeError, "Invalid .npy file");
+#ifdef WORDS_BIGENDIAN
+    d_array_from_le(len, (const char*)data, data);
+#endif
+}
@@ -0,0 +1,28 @@
+#ifndef FAST_MATRIX_SERIALIZATION_H
+#define FAST_MATRIX_SERIALIZATION_H 1
+
+#include "ruby.h"
+
+//  binary form: 4 bytes of signature, ndim little-endian int32 sizes,
+//  zero padding to 8 bytes and little-endian doubles
+VALUE d_array_to_binary(const char* signature, int ndim, const int* shape, const double* data);
+//  check that the product of sizes can be allocated as an array of doubles
+bool d_array_shape_fits(int ndim, const int* shape);
+//  size of the binary form before elements
+long binary_header_size(int ndim);
+void write_binary_header(char* p, const char* signature, int ndim, const int* shape);
+//  check the signature of the binary form in size bytes and read its sizes
+bool read_binary_header(const char* p, long size, const char* signature, int ndim, int* shape);
+//  check the signature of the binary form and read its sizes or raise an error if this is not possible
+void raise_check_binary(VALUE str, const char* signature, int ndim, int* shape);
+//  read elements of the binary form checked by raise_check_binary
+void d_array_from_binary(VALUE str, int ndim, double* data);
+
+//  write elements to .npy file of format version 1.0
+void raise_save_npy(VALUE path, int ndim, const int* shape, const double* data);
+//  open .npy file and read its sizes, the file is positioned at the elements
+FILE* raise_open_npy(VALUE path, int* ndim, int* shape, bool* fortran_order);
+//  read elements of the opened .npy file and close it
+void raise_read_npy(FILE* file, VALUE path, int len, double* data);
+
+#endif /* FAST_MATRIX_SERIALIZATION_H */
@@ -0,0 +1,30 @@
+#include "Helper/standard.h"
+
+VALUE get_standard_array(VALUE obj, const char* class_name, const char* ivar)
+{
+    if(RB_SPECIAL_CONST_P(obj) || !RB_TYPE_P(obj, T_OBJECT))
+        return Qnil;
+
+    ID class_id = rb_intern(class_name);
+    if(!rb_const_defined(rb_cObject, class_id))
+        return Qnil;
+    if(!RTEST(rb_obj_is_kind_of(obj, rb_const_get(rb_cObject, class_id))))
+        return Qnil;
+
+    VALUE array = rb_attr_get(obj, rb_intern(ivar));
+    if(!RB_TYPE_P(array, T_ARRAY))
+        return Qnil;
+    return array;
+}
+
+VALUE get_standard_class(const char* class_name)
+{
+    return rb_const_get(rb_cObject, rb_intern(class_name));
+}
+
+double rb_value_to_f(VALUE v)
+{
+    if(RB_FLOAT_TYPE_P(v) || FIXNUM_P(v))
+        return NUM2DBL(v);
+    return NUM2DBL(rb_funcall(v, rb_intern("to_f"), 0));
+}
@@ -0,0 +1,14 @@
+#ifndef FAST_MATRIX_STANDARD_H
+#define FAST_MATRIX_STANDARD_H 1
+
+#include "ruby.h"
+
+//  array of elements from the instance variable of the standard ::Matrix or ::Vector,
+//  Qnil if obj is not an instance of the standard class or the library is not loaded
+VALUE get_standard_array(VALUE obj, const char* class_name, const char* ivar);
+//  class of the standard library, raises NameError if the library is not loaded
+VALUE get_standard_class(const char* class_name);
+//  element of a standard object as double, other numerics are converted by to_f
+double rb_value_to_f(VALUE v);
+
+#endif /* FAST_MATRIX_STANDARD_H */
@@ -0,0 +1,80 @@
+#include "KroneckerMatrix/c_kronecker.h"
+#include "Matrix/c_matrix.h"
+#include "Helper/c_array_operations.h"
+
+// A - matrix am x an
+// B - matrix bm x bn
+// R - matrix (am * bm) x (an * bn)
+void c_kronecker_product(int am, int an, const double* A, int bm, int bn, const double* B, double* R)
+{
+    int m = am * bm;
+    for(int p = 0; p < an; ++p)
+    {
+        const double* p_a = A + p * am;
+        for(int q = 0; q < bn; ++q)
+        {
+            const double* p_b = B + q * bm;
+            double* p_r = R + (p * bn + q) * m;
+            for(int i = 0; i < am; ++i)
+                multiply_d_array_to_result(bm, p_b, p_a[i], p_r + i * bm);
+        }
+    }
+}
+
+// R[r, q] = T[r] * B[q], R = T * B^T
+// T - matrix bm x rows
+// B - matrix bm x bn
+// R - matrix bn x rows
+void c_kronecker_multiply_transposed(int rows, int bm, int bn, const double* T, const double* B, double* R)
+{
+    for(int r = 0; r < rows; ++r)
+        for(int q = 0; q < bn; ++q)
+            R[r * bn + q] = dot_d_arrays(bm, T + r * bm, B + q * bm);
+}
+
+// Y = (A x B) * X without forming the product:
+// with X as the matrix bm x am and Y as the matrix bn x an, Y = A * X * B^T,
+// the cheaper order of the two multiplications is used
+// X - vector am * bm
+// Y - vector an * bn
+void c_kronecker_vector_multiply(int am, int an, const double* A, int bm, int bn, const double* B,
+    const double* X, double* Y)
+{
+    double right_first = (double)am * bn * (bm + an);
+    double left_first = (double)an * bm * (am + bn);
+
+    if(right_first <= left_first)
+    {
+        double* T = malloc(am * bn * sizeof(double));
+        c_kronecker_multiply_transposed(am, bm, bn, X, B, T);
+        c_matrix_multiply(an, am, bn, A, T, Y);
+        free(T);
+    }
+    else
+    {
+        double* T = malloc(an * bm * sizeof(double));
+        c_matrix_multiply(an, am, bm, A, X, T);
+        c_kronecker_multiply_transposed(an, bm, bn, T, B, Y);
+        free(T);
+    }
+}
+
+// Y = (A x B) * X
+// X - matrix p x (am * bm)
+// Y - matrix p x (an * bn)
+void c_kronecker_matrix_multiply(int am, int an, const double* A, int bm, int bn, const double* B,
+    int p, const double* X, double* Y)
+{
+    int m = am * bm;
+    int n = an * bn;
+    double* columns = malloc(p * m * sizeof(double));
+    double* results = malloc(p * n * sizeof(double));
+
+    c_matrix_transpose(p, m, X, columns);
+    for(int r = 0; r < p; ++r)
+        c_kronecker_vector_multiply(am, an, A, bm, bn, B, columns + r * m, results + r * n);
+    c_matrix_transpose(n, p, results, Y);
+
+    free(columns);
+    free(results);
+}
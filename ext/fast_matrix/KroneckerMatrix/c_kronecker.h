@@ -0,0 +1,13 @@
+#ifndef FAST_MATRIX_KRONECKERMATRIX_C_KRONECKER_H
+#define FAST_MATRIX_KRONECKERMATRIX_C_KRONECKER_H 1
+
+// the element (p * bn + q, i * bm + j) of the Kronecker product of
+// the matrix A am x an and the matrix B bm x bn is A[p, i] * B[q, j]
+
+void c_kronecker_product(int am, int an, const double* A, int bm, int bn, const double* B, double* R);
+void c_kronecker_vector_multiply(int am, int an, const double* A, int bm, int bn, const double* B,
+    const double* X, double* Y);
+void c_kronecker_matrix_multiply(int am, int an, const double* A, int bm, int bn, const double* B,
+    int p, const double* X, double* Y);
+
+#endif /* FAST_MATRIX_KRONECKERMATRIX_C_KRONECKER_H */
@@ -0,0 +1,206 @@
+#include "KroneckerMatrix/kronecker.h"
+#include "KroneckerMatrix/c_kronecker.h"
+#include "Matrix/matrix.h"
+#include "Matrix/helper.h"
+#include "Vector/vector.h"
+#include "Vector/helper.h"
+#include "Helper/c_array_operations.h"
+#include "Helper/errors.h"
+
+VALUE cKroneckerMatrix;
+
+// Kronecker product A x B of two matrices that is never formed,
+// the factors are clones, so later changes of the originals do not affect it
+struct kronecker_matrix
+{
+    VALUE a;
+    VALUE b;
+};
+
+void kronecker_mark(void* data);
+size_t kronecker_size(const void* data);
+
+const rb_data_type_t kronecker_type =
+{
+    .wrap_struct_name = "kronecker_matrix",
+    .function =
+    {
+        .dmark = kronecker_mark,
+        .dfree = RUBY_DEFAULT_FREE,
+        .dsize = kronecker_size,
+    },
+    .data = NULL,
+    .flags = RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+void kronecker_mark(void* data)
+{
+    struct kronecker_matrix* K = data;
+    rb_gc_mark(K->a);
+    rb_gc_mark(K->b);
+}
+
+size_t kronecker_size(const void* data)
+{
+    return sizeof(struct kronecker_matrix);
+}
+
+VALUE kronecker_alloc(VALUE self)
+{
+    struct kronecker_matrix* K;
+    VALUE result = TypedData_Make_Struct(self, struct kronecker_matrix, &kronecker_type, K);
+    K->a = Qnil;
+    K->b = Qnil;
+    return result;
+}
+
+struct kronecker_matrix* get_kronecker_from_rb_value(VALUE k)
+{
+	struct kronecker_matrix* data;
+	TypedData_Get_Struct(k, struct kronecker_matrix, &kronecker_type, data);
+    if(NIL_P(data->a))
+        rb_raise(fm_eTypeError, "Uninitialized Kronecker matrix");
+    return data;
+}
+
+VALUE make_kronecker(VALUE a, VALUE b)
+{
+    VALUE result = kronecker_alloc(cKroneckerMatrix);
+    struct kronecker_matrix* K = DATA_PTR(result);
+    K->a = a;
+    K->b = b;
+    return result;
+}
+
+//  KroneckerMatrix.new(a, b)
+VALUE kronecker_initialize(VALUE self, VALUE a, VALUE b)
+{
+    raise_check_rbasic(a, cMatrix, "matrix");
+    raise_check_rbasic(b, cMatrix, "matrix");
+
+    struct kronecker_matrix* K;
+	TypedData_Get_Struct(self, struct kronecker_matrix, &kronecker_type, K);
+    K->a = rb_funcall(a, rb_intern("clone"), 0);
+    K->b = rb_funcall(b, rb_intern("clone"), 0);
+    return self;
+}
+
+//  Matrix#kron(other), the product is formed
+VALUE matrix_kron(VALUE self, VALUE other)
+{
+    raise_check_rbasic(other, cMatrix, "matrix");
+	struct matrix* A = get_matrix_from_rb_value(self);
+	struct matrix* B = get_matrix_from_rb_value(other);
+
+    MAKE_MATRIX_AND_RB_VALUE(R, result, A->m * B->m, A->n * B->n);
+    c_kronecker_product(A->m, A->n, A->data, B->m, B->n, B->data, R->data);
+    return result;
+}
+
+VALUE kronecker_row_count(VALUE self)
+{
+    struct kronecker_matrix* K = get_kronecker_from_rb_value(self);
+    return INT2NUM(get_matrix_from_rb_value(K->a)->n * get_matrix_from_rb_value(K->b)->n);
+}
+
+VALUE kronecker_column_count(VALUE self)
+{
+    struct kronecker_matrix* K = get_kronecker_from_rb_value(self);
+    return INT2NUM(get_matrix_from_rb_value(K->a)->m * get_matrix_from_rb_value(K->b)->m);
+}
+
+VALUE kronecker_factors(VALUE self)
+{
+    struct kronecker_matrix* K = get_kronecker_from_rb_value(self);
+    return rb_assoc_new(K->a, K->b);
+}
+
+VALUE kronecker_get(VALUE self, VALUE row, VALUE column)
+{
+    struct kronecker_matrix* K = get_kronecker_from_rb_value(self);
+	struct matrix* A = get_matrix_from_rb_value(K->a);
+	struct matrix* B = get_matrix_from_rb_value(K->b);
+    int m = raise_rb_value_to_int(column);
+    int n = raise_rb_value_to_int(row);
+
+    m = (m < 0) ? A->m * B->m + m : m;
+    n = (n < 0) ? A->n * B->n + n : n;
+
+    if(m < 0 || n < 0 || n >= A->n * B->n || m >= A->m * B->m)
+        return Qnil;
+
+    return DBL2NUM(A->data[m / B->m + (n / B->n) * A->m] * B->data[m % B->m + (n % B->n) * B->m]);
+}
+
+VALUE kronecker_to_matrix(VALUE self)
+{
+    struct kronecker_matrix* K = get_kronecker_from_rb_value(self);
+    return matrix_kron(K->a, K->b);
+}
+
+//  factors are cloned too, since they can be changed through factors
+VALUE kronecker_copy(VALUE self)
+{
+    struct kronecker_matrix* K = get_kronecker_from_rb_value(self);
+    return make_kronecker(rb_funcall(K->a, rb_intern("clone"), 0),
+        rb_funcall(K->b, rb_intern("clone"), 0));
+}
+
+VALUE kronecker_transpose(VALUE self)
+{
+    struct kronecker_matrix* K = get_kronecker_from_rb_value(self);
+    return make_kronecker(rb_funcall(K->a, rb_intern("transpose"), 0),
+        rb_funcall(K->b, rb_intern("transpose"), 0));
+}
+
+VALUE kronecker_multiply(VALUE self, VALUE v)
+{
+    struct kronecker_matrix* K = get_kronecker_from_rb_value(self);
+	struct matrix* A = get_matrix_from_rb_value(K->a);
+	struct matrix* B = get_matrix_from_rb_value(K->b);
+
+    if(RB_FLOAT_TYPE_P(v) || FIXNUM_P(v)
+        || RB_TYPE_P(v, T_BIGNUM))
+        return make_kronecker(rb_funcall(K->a, rb_intern("*"), 1, v), K->b);
+    if(RB_SPECIAL_CONST_P(v))
+        rb_raise(fm_eTypeError, "Invalid klass for multiply");
+
+    if(RBASIC_CLASS(v) == cVector)
+    {
+        struct vector* X = get_vector_from_rb_value(v);
+        if(X->n != A->m * B->m)
+            rb_raise(fm_eIndexError, "Matrix columns differs from vector size");
+        MAKE_VECTOR_AND_RB_VALUE(Y, result, A->n * B->n);
+        c_kronecker_vector_multiply(A->m, A->n, A->data, B->m, B->n, B->data, X->data, Y->data);
+        return result;
+    }
+    if(RBASIC_CLASS(v) == cMatrix)
+    {
+        struct matrix* X = get_matrix_from_rb_value(v);
+        if(X->n != A->m * B->m)
+            rb_raise(fm_eIndexError, "First columns differs from second rows");
+        MAKE_MATRIX_AND_RB_VALUE(Y, result, X->m, A->n * B->n);
+        c_kronecker_matrix_multiply(A->m, A->n, A->data, B->m, B->n, B->data, X->m, X->data, Y->data);
+        return result;
+    }
+    rb_raise(fm_eTypeError, "Invalid klass for multiply");
+}
+
+void init_fm_kronecker()
+{
+    VALUE  mod = rb_define_module("FastMatrix");
+	cKroneckerMatrix = rb_define_class_under(mod, "KroneckerMatrix", rb_cData);
+	rb_define_alloc_func(cKroneckerMatrix, kronecker_alloc);
+
+	rb_define_method(cKroneckerMatrix, "initialize", kronecker_initialize, 2);
+	rb_define_method(cKroneckerMatrix, "row_count", kronecker_row_count, 0);
+	rb_define_method(cKroneckerMatrix, "column_count", kronecker_column_count, 0);
+	rb_define_method(cKroneckerMatrix, "factors", kronecker_factors, 0);
+	rb_define_method(cKroneckerMatrix, "[]", kronecker_get, 2);
+	rb_define_method(cKroneckerMatrix, "to_matrix", kronecker_to_matrix, 0);
+	rb_define_method(cKroneckerMatrix, "clone", kronecker_copy, 0);
+	rb_define_method(cKroneckerMatrix, "transpose", kronecker_transpose, 0);
+	rb_define_method(cKroneckerMatrix, "*", kronecker_multiply, 1);
+
+	rb_define_method(cMatrix, "kron", matrix_kron, 1);
+}
@@ -0,0 +1,10 @@
+#ifndef FAST_MATRIX_KRONECKERMATRIX_H
+#define FAST_MATRIX_KRONECKERMATRIX_H 1
+
+#include "ruby.h"
+
+extern VALUE cKroneckerMatrix;
+extern const rb_data_type_t kronecker_type;
+void init_fm_kronecker();
+
+#endif /* FAST_MATRIX_KRONECKERMATRIX_H */
@@ -1,5 +1,8 @@
 #include "LUPDecomposition/c_lup.h"
 #include "Helper/c_array_operations.h"
+#include "Matrix/c_matrix.h"
+#include <math.h>
+#include <stdlib.h>
 
 void c_lup_l(int n, const double* LUP, double* L)
 {
@@ -68,19 +71,22 @@ void c_lup_solve(int m, int n, const double* lp, const double* B, const int* per
     c_lup_apply_permutation(m, n, B, permutation, R);
 
     for(int k = 0; k < n; ++k)
+    {
+        const double* line = R + k * m;
         for(int i = k + 1; i < n; ++i)
         {
-            double* line = R + i * m;
-            int mul = lp[i * n + k];
+            double* line_out = R + i * m;
+            double mul = lp[i * n + k];
 
             for(int j = 0; j < m; ++j)
-                line[j] -= line[j] * mul;
+                line_out[j] -= line[j] * mul;
         }
+    }
     
     for(int k = n - 1; k >= 0; --k)
     {
         double* line = R + k * m;
-        int div = lp[k * n + k];
+        double div = lp[k * n + k];
 
         for(int j = 0; j < m; ++j)
             line[j] /= div;
@@ -88,10 +94,136 @@ void c_lup_solve(int m, int n, const double* lp, const double* B, const int* per
         for(int i = 0; i < k; ++i)
         {
             double* line_out = R + i * m;
-            int mul = lp[i * n + k];
+            double mul = lp[i * n + k];
             
             for(int j = 0; j < m; ++j)
                 line_out[j] -= line[j] * mul;
         }
     }
 }
+
+//  pivots that lost this part of their terms are too inaccurate,
+//  the updated matrix is decomposed again with pivoting
+#define LUP_UPDATE_PIVOT_RATIO 1e-8
+
+//  rank-1 update LU + x * y^T of the factors without pivoting (Bennett's algorithm)
+//  x and y are destroyed, returns false on a small pivot leaving LU partially updated
+bool c_lup_rank1_update(int n, double* LU, double* x, double* y)
+{
+    for(int k = 0; k < n; ++k)
+    {
+        double* line = LU + k * n;
+        double alpha = line[k];
+        double xy = x[k] * y[k];
+        double beta = alpha + xy;
+        if(fabs(beta) <= LUP_UPDATE_PIVOT_RATIO * (fabs(alpha) + fabs(xy)))
+            return false;
+
+        line[k] = beta;
+        for(int j = k + 1; j < n; ++j)
+        {
+            double u = line[j];
+            line[j] = u + x[k] * y[j];
+            y[j] = (alpha * y[j] - y[k] * u) / beta;
+        }
+        for(int i = k + 1; i < n; ++i)
+        {
+            double* l = LU + i * n + k;
+            double old = *l;
+            *l = (old * alpha + x[i] * y[k]) / beta;
+            x[i] -= x[k] * old;
+        }
+    }
+    return true;
+}
+
+//  product L * U of the packed factors
+void c_lup_product(int n, const double* LUP, double* R)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        const double* lup_line = LUP + n * i;
+        double* r_line = R + n * i;
+        fill_d_array(i, r_line, 0);
+        copy_d_array(n - i, lup_line + i, r_line + i);
+        for(int k = 0; k < i; ++k)
+            if(lup_line[k] != 0)
+                add_scaled_d_array_to_first(n - k, r_line + k, lup_line[k], LUP + n * k + k);
+    }
+}
+
+//  decomposes P^T (LU + x * y^T) from scratch
+void c_lup_decompose_updated(struct lupdecomposition* lp, const double* x, const double* y)
+{
+    int n = lp->n;
+    double* PA = malloc(2 * n * n * sizeof(double));
+    double* A = PA + n * n;
+
+    c_lup_product(n, lp->data, PA);
+    for(int i = 0; i < n; ++i)
+    {
+        add_scaled_d_array_to_first(n, PA + n * i, x[i], y);
+        copy_d_array(n, PA + n * i, A + n * lp->permutation[i]);
+    }
+    c_matrix_lup(n, A, lp->data, lp->permutation, &(lp->pivot_sign), &(lp->singular));
+    free(PA);
+}
+
+//  decomposition of A + u * v^T from the decomposition of A in O(n^2),
+//  elements of u and v are taken with the given stride
+void c_lup_update(struct lupdecomposition* lp, const double* u, const double* v, int stride)
+{
+    int n = lp->n;
+    double* LU = malloc(n * n * sizeof(double));
+    double* buffer = malloc(4 * n * sizeof(double));
+    double* x = buffer;
+    double* y = buffer + n;
+
+    for(int i = 0; i < n; ++i)
+    {
+        x[i] = u[lp->permutation[i] * stride];
+        y[i] = v[i * stride];
+    }
+    copy_d_array(n * n, lp->data, LU);
+    copy_d_array(2 * n, buffer, buffer + 2 * n);
+
+    if(c_lup_rank1_update(n, LU, buffer + 2 * n, buffer + 3 * n))
+    {
+        double* old = lp->data;
+        lp->data = LU;
+        lp->singular = false;
+        LU = old;
+    }
+    else
+        c_lup_decompose_updated(lp, x, y);
+
+    free(LU);
+    free(buffer);
+}
+
+//  replaces column j of A by the column C with the rank-1 update
+//  u = C - A e_j, v = e_j, where P A e_j is column j of LU
+void c_lup_replace_column(struct lupdecomposition* lp, int j, const double* C)
+{
+    int n = lp->n;
+    double* buffer = malloc(2 * n * sizeof(double));
+    double* u = buffer;
+    double* v = buffer + n;
+
+    fill_d_array(n, v, 0);
+    v[j] = 1;
+    for(int i = 0; i < n; ++i)
+    {
+        const double* lup_line = lp->data + n * i;
+        int last = i < j ? i : j;
+        double sum = i <= j ? lup_line[j] : 0;
+        for(int k = 0; k < last; ++k)
+            sum += lup_line[k] * lp->data[n * k + j];
+        if(i > j)
+            sum += lup_line[j] * lp->data[n * j + j];
+        u[lp->permutation[i]] = C[lp->permutation[i]] - sum;
+    }
+
+    c_lup_update(lp, u, v, 1);
+    free(buffer);
+}
@@ -19,4 +19,9 @@ void c_lup_u(int n, const double* LUP, double* U);
 void c_lup_p(int n, const int* prm, double* P);
 void c_lup_solve(int m, int n, const double* lp, const double* B, const int* permutation, double* R);
 
+bool c_lup_rank1_update(int n, double* LU, double* x, double* y);
+void c_lup_product(int n, const double* LUP, double* R);
+void c_lup_update(struct lupdecomposition* lp, const double* u, const double* v, int stride);
+void c_lup_replace_column(struct lupdecomposition* lp, int j, const double* C);
+
 #endif /* FAST_MATRIX_MATRIX_C_LUPDECOMPOSITION_H */
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "LUPDecomposition/helper.h"
 #include "Matrix/matrix.h"
 #include "Matrix/helper.h"
+#include "Vector/vector.h"
+#include "Vector/helper.h"
 #include "Helper/errors.h"
 
 VALUE cLUPDecomposition;
@@ -96,11 +98,22 @@ VALUE lup_pivots(VALUE self)
 
 VALUE lup_solve(VALUE self, VALUE mtrx)
 {
-    raise_check_rbasic(mtrx, cMatrix, "matrix");
 	struct lupdecomposition* lp = get_lup_from_rb_value(self);
-	struct matrix* M = get_matrix_from_rb_value(mtrx);
     if(lp->singular)
         rb_raise(fm_eIndexError, "Matrix is singular");
+
+    if(!RB_SPECIAL_CONST_P(mtrx) && RBASIC_CLASS(mtrx) == cVector)
+    {
+        struct vector* V = get_vector_from_rb_value(mtrx);
+        if(lp->n != V->n)
+            rb_raise(fm_eIndexError, "Matrix columns differs from vector size");
+        MAKE_VECTOR_AND_RB_VALUE(X, result, lp->n);
+        c_lup_solve(1, lp->n, lp->data, V->data, lp->permutation, X->data);
+        return result;
+    }
+
+    raise_check_rbasic(mtrx, cMatrix, "matrix");
+	struct matrix* M = get_matrix_from_rb_value(mtrx);
     if(lp->n != M->n)
         rb_raise(fm_eIndexError, "Columns of different size");
 
@@ -109,6 +122,51 @@ VALUE lup_solve(VALUE self, VALUE mtrx)
     return result;
 }
 
+//  update!(u, v) decomposes A + u * v^T, a pair of matrices n x k
+//  gives k rank-1 updates by their columns
+VALUE lup_update(VALUE self, VALUE u, VALUE v)
+{
+	struct lupdecomposition* lp = get_lup_from_rb_value(self);
+    if(!RB_SPECIAL_CONST_P(u) && RBASIC_CLASS(u) == cVector)
+    {
+        raise_check_rbasic(v, cVector, "vector");
+        struct vector* U = get_vector_from_rb_value(u);
+        struct vector* V = get_vector_from_rb_value(v);
+        if(U->n != lp->n || V->n != lp->n)
+            rb_raise(fm_eIndexError, "Sizes of vectors differ from matrix size");
+        c_lup_update(lp, U->data, V->data, 1);
+        return self;
+    }
+
+    raise_check_rbasic(u, cMatrix, "matrix");
+    raise_check_rbasic(v, cMatrix, "matrix");
+	struct matrix* U = get_matrix_from_rb_value(u);
+	struct matrix* V = get_matrix_from_rb_value(v);
+    if(U->n != lp->n || V->n != lp->n)
+        rb_raise(fm_eIndexError, "Columns of different size");
+    if(U->m != V->m)
+        rb_raise(fm_eIndexError, "Different sizes matrices");
+
+    for(int i = 0; i < U->m; ++i)
+        c_lup_update(lp, U->data + i, V->data + i, U->m);
+    return self;
+}
+
+VALUE lup_replace_column(VALUE self, VALUE idx, VALUE column)
+{
+	struct lupdecomposition* lp = get_lup_from_rb_value(self);
+    int j = raise_rb_value_to_int(idx);
+    raise_check_rbasic(column, cVector, "vector");
+    struct vector* C = get_vector_from_rb_value(column);
+    if(j < 0 || j >= lp->n)
+        rb_raise(fm_eIndexError, "Index out of range");
+    if(C->n != lp->n)
+        rb_raise(fm_eIndexError, "Matrix columns differs from vector size");
+
+    c_lup_replace_column(lp, j, C->data);
+    return self;
+}
+
 void init_fm_lup()
 {
 	cLUPDecomposition = rb_define_class_under(cMatrix, "LUPDecomposition", rb_cData);
@@ -121,4 +179,6 @@ void init_fm_lup()
 	rb_define_method(cLUPDecomposition, "singular?", lup_singular, 0);
 	rb_define_method(cLUPDecomposition, "pivots", lup_pivots, 0);
 	rb_define_method(cLUPDecomposition, "solve", lup_solve, 1);
+	rb_define_method(cLUPDecomposition, "update!", lup_update, 2);
+	rb_define_method(cLUPDecomposition, "replace_column!", lup_replace_column, 2);
 }
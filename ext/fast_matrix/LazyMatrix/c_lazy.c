@@ -0,0 +1,162 @@
+#include "LazyMatrix/c_lazy.h"
+#include "Helper/c_array_operations.h"
+
+// entry of the evaluation stack:
+// either a scalar or a pointer to LAZY_BLOCK_SIZE elements
+struct lazy_operand
+{
+    const double* data;
+    double value;
+    bool scalar;
+};
+
+int c_lazy_arity(enum lazy_operation op)
+{
+    switch(op)
+    {
+        case LAZY_MATRIX:
+        case LAZY_SCALAR:
+            return 0;
+        case LAZY_NEGATE:
+        case LAZY_ABS:
+            return 1;
+        default:
+            return 2;
+    }
+}
+
+double lazy_apply_scalar(enum lazy_operation op, double a, double b)
+{
+    switch(op)
+    {
+        case LAZY_ADD:      return a + b;
+        case LAZY_SUB:      return a - b;
+        case LAZY_MULTIPLY: return a * b;
+        case LAZY_DIVIDE:   return a / b;
+        case LAZY_NEGATE:   return -a;
+        case LAZY_ABS:      return fabs(a);
+        default:            return 0;
+    }
+}
+
+void lazy_apply_unary(int len, enum lazy_operation op, const double* A, double* R)
+{
+    if(op == LAZY_NEGATE)
+        multiply_d_array_to_result(len, A, -1, R);
+    else
+        abs_d_array(len, A, R);
+}
+
+void lazy_apply_binary(int len, enum lazy_operation op, const struct lazy_operand* a, const struct lazy_operand* b, double* R)
+{
+    const double* A = a->data;
+    const double* B = b->data;
+    double va = a->value;
+    double vb = b->value;
+
+    if(!a->scalar && !b->scalar)
+        switch(op)
+        {
+            case LAZY_ADD:      add_d_arrays_to_result(len, A, B, R); return;
+            case LAZY_SUB:      sub_d_arrays_to_result(len, A, B, R); return;
+            case LAZY_MULTIPLY: multiply_elems_d_array_to_result(len, A, B, R); return;
+            default:            for(int i = 0; i < len; ++i) R[i] = A[i] / B[i]; return;
+        }
+
+    if(b->scalar)
+        switch(op)
+        {
+            case LAZY_ADD:      for(int i = 0; i < len; ++i) R[i] = A[i] + vb; return;
+            case LAZY_SUB:      for(int i = 0; i < len; ++i) R[i] = A[i] - vb; return;
+            case LAZY_MULTIPLY: multiply_d_array_to_result(len, A, vb, R); return;
+            default:            multiply_d_array_to_result(len, A, 1 / vb, R); return;
+        }
+
+    switch(op)
+    {
+        case LAZY_ADD:      for(int i = 0; i < len; ++i) R[i] = va + B[i]; return;
+        case LAZY_SUB:      for(int i = 0; i < len; ++i) R[i] = va - B[i]; return;
+        case LAZY_MULTIPLY: multiply_d_array_to_result(len, B, va, R); return;
+        default:            for(int i = 0; i < len; ++i) R[i] = va / B[i]; return;
+    }
+}
+
+// evaluates the program for len elements starting from offset,
+// intermediate results are stored in buffer of depth blocks
+void lazy_evaluate_block(int len, int offset, int count, const struct lazy_instruction* program,
+    struct lazy_operand* stack, double* buffer, double* R)
+{
+    int top = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        const struct lazy_instruction* ins = program + i;
+        enum lazy_operation op = ins->op;
+        double* out = buffer + top * LAZY_BLOCK_SIZE;
+
+        if(op == LAZY_MATRIX)
+        {
+            stack[top].data = ins->data + offset;
+            stack[top].scalar = false;
+            ++top;
+        }
+        else if(op == LAZY_SCALAR)
+        {
+            stack[top].value = ins->value;
+            stack[top].scalar = true;
+            ++top;
+        }
+        else if(c_lazy_arity(op) == 1)
+        {
+            struct lazy_operand* a = stack + top - 1;
+            if(a->scalar)
+                a->value = lazy_apply_scalar(op, a->value, 0);
+            else
+            {
+                out = buffer + (top - 1) * LAZY_BLOCK_SIZE;
+                lazy_apply_unary(len, op, a->data, out);
+                a->data = out;
+            }
+        }
+        else
+        {
+            struct lazy_operand* a = stack + top - 2;
+            struct lazy_operand* b = stack + top - 1;
+            out = buffer + (top - 2) * LAZY_BLOCK_SIZE;
+            if(a->scalar && b->scalar)
+                a->value = lazy_apply_scalar(op, a->value, b->value);
+            else
+            {
+                lazy_apply_binary(len, op, a, b, out);
+                a->data = out;
+                a->scalar = false;
+            }
+            --top;
+        }
+    }
+
+    if(stack[0].scalar)
+        fill_d_array(len, R + offset, stack[0].value);
+    else
+        copy_d_array(len, stack[0].data, R + offset);
+}
+
+// len     - number of elements in every matrix of the program
+// count   - number of instructions
+// depth   - max size of the evaluation stack
+// R       - result, len elements
+void c_lazy_evaluate(int len, int count, const struct lazy_instruction* program, int depth, double* R)
+{
+    struct lazy_operand* stack = malloc(depth * sizeof(struct lazy_operand));
+    double* buffer = malloc(depth * LAZY_BLOCK_SIZE * sizeof(double));
+
+    for(int offset = 0; offset < len; offset += LAZY_BLOCK_SIZE)
+    {
+        int block = len - offset;
+        if(block > LAZY_BLOCK_SIZE)
+            block = LAZY_BLOCK_SIZE;
+        lazy_evaluate_block(block, offset, count, program, stack, buffer, R);
+    }
+
+    free(stack);
+    free(buffer);
+}
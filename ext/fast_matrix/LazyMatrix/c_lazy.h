@@ -0,0 +1,34 @@
+#ifndef FAST_MATRIX_LAZYMATRIX_C_LAZY_H
+#define FAST_MATRIX_LAZYMATRIX_C_LAZY_H 1
+
+#include <stdbool.h>
+
+// number of elements evaluated by one pass of the program
+#define LAZY_BLOCK_SIZE 512
+
+enum lazy_operation
+{
+    LAZY_MATRIX,
+    LAZY_SCALAR,
+    LAZY_ADD,
+    LAZY_SUB,
+    LAZY_MULTIPLY,
+    LAZY_DIVIDE,
+    LAZY_NEGATE,
+    LAZY_ABS,
+};
+
+// one instruction of the program in postfix notation
+// data  - elements of the matrix for LAZY_MATRIX
+// value - value for LAZY_SCALAR
+struct lazy_instruction
+{
+    enum lazy_operation op;
+    const double* data;
+    double value;
+};
+
+int c_lazy_arity(enum lazy_operation op);
+void c_lazy_evaluate(int len, int count, const struct lazy_instruction* program, int depth, double* R);
+
+#endif /* FAST_MATRIX_LAZYMATRIX_C_LAZY_H */
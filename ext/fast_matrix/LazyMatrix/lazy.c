@@ -0,0 +1,106 @@
+#include "LazyMatrix/lazy.h"
+#include "LazyMatrix/c_lazy.h"
+#include "Matrix/matrix.h"
+#include "Matrix/helper.h"
+#include "Helper/errors.h"
+
+VALUE cLazyMatrix;
+
+enum lazy_operation lazy_operation_from_rb_value(VALUE v)
+{
+    if(RB_FLOAT_TYPE_P(v) || FIXNUM_P(v) || RB_TYPE_P(v, T_BIGNUM))
+        return LAZY_SCALAR;
+    if(!SYMBOL_P(v))
+    {
+        if(RB_SPECIAL_CONST_P(v) || RBASIC_CLASS(v) != cMatrix)
+            rb_raise(fm_eTypeError, "Invalid instruction");
+        return LAZY_MATRIX;
+    }
+
+    ID id = SYM2ID(v);
+    if(id == rb_intern("+"))
+        return LAZY_ADD;
+    if(id == rb_intern("-"))
+        return LAZY_SUB;
+    if(id == rb_intern("*"))
+        return LAZY_MULTIPLY;
+    if(id == rb_intern("/"))
+        return LAZY_DIVIDE;
+    if(id == rb_intern("-@"))
+        return LAZY_NEGATE;
+    if(id == rb_intern("abs"))
+        return LAZY_ABS;
+    rb_raise(fm_eTypeError, "Invalid operation");
+}
+
+//  check the program and find the size of matrices and of the evaluation stack
+void lazy_check_program(int count, const VALUE* program, int* m, int* n, int* depth)
+{
+    int top = 0;
+    *m = 0;
+    *n = 0;
+    *depth = 0;
+    for(int i = 0; i < count; ++i)
+    {
+        enum lazy_operation op = lazy_operation_from_rb_value(program[i]);
+        if(op == LAZY_MATRIX)
+        {
+            struct matrix* M = get_matrix_from_rb_value(program[i]);
+            if(*m == 0)
+            {
+                *m = M->m;
+                *n = M->n;
+            }
+            else if(*m != M->m || *n != M->n)
+                rb_raise(fm_eIndexError, "Different sizes matrices");
+        }
+
+        top = top - c_lazy_arity(op) + 1;
+        if(top <= 0)
+            rb_raise(fm_eTypeError, "Not enough operands");
+        if(top > *depth)
+            *depth = top;
+    }
+
+    if(top != 1)
+        rb_raise(fm_eTypeError, "Too many operands");
+    if(*m == 0)
+        rb_raise(fm_eTypeError, "Expected at least one matrix");
+}
+
+//  evaluate the program in postfix notation in one pass over the elements
+VALUE lazy_evaluate(VALUE obj, VALUE program)
+{
+    Check_Type(program, T_ARRAY);
+    int count = RARRAY_LEN(program);
+    const VALUE* p_program = RARRAY_CONST_PTR(program);
+
+    int m, n, depth;
+    lazy_check_program(count, p_program, &m, &n, &depth);
+
+    struct lazy_instruction* instructions = malloc(count * sizeof(struct lazy_instruction));
+    for(int i = 0; i < count; ++i)
+    {
+        VALUE v = p_program[i];
+        struct lazy_instruction* ins = instructions + i;
+        ins->op = lazy_operation_from_rb_value(v);
+        if(ins->op == LAZY_MATRIX)
+            ins->data = get_matrix_from_rb_value(v)->data;
+        else if(ins->op == LAZY_SCALAR)
+            ins->value = NUM2DBL(v);
+    }
+
+    MAKE_MATRIX_AND_RB_VALUE(R, result, m, n);
+    c_lazy_evaluate(m * n, count, instructions, depth, R->data);
+
+    free(instructions);
+    return result;
+}
+
+void init_fm_lazy()
+{
+    VALUE  mod = rb_define_module("FastMatrix");
+	cLazyMatrix = rb_define_class_under(mod, "LazyMatrix", rb_cObject);
+
+    rb_define_module_function(cLazyMatrix, "evaluate", lazy_evaluate, 1);
+}
@@ -0,0 +1,9 @@
+#ifndef FAST_MATRIX_LAZYMATRIX_H
+#define FAST_MATRIX_LAZYMATRIX_H 1
+
+#include "ruby.h"
+
+extern VALUE cLazyMatrix;
+void init_fm_lazy();
+
+#endif /* FAST_MATRIX_LAZYMATRIX_H */
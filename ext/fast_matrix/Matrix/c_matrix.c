@@ -1,5 +1,7 @@
 #include "c_matrix.h"
 #include "Helper/c_array_operations.h"
+#include "LUPDecomposition/c_lup.h"
+#include <float.h>
 
 // in  - matrix m x n
 // out - matrix n x m
@@ -275,17 +277,9 @@ void c_matrix_column_vector(int m, int n, const double* M, double* V, int idx)
 
 void c_matrix_scalar(int n, double* C, double v)
 {
-    int ptr = 0;
-    
-    for(int i = 0; i < n * n; ++i)
-    {
-        if(i == ptr)
-        {
-            ptr += n + 1;
-            C[i] = v;
-        }else
-            C[i] = 0;
-    }
+    fill_d_array(n * n, C, 0);
+    for(int i = 0; i < n; ++i)
+        C[i * (n + 1)] = v;
 }
 
 bool c_matrix_symmetric(int n, const double* C)
@@ -615,38 +609,52 @@ bool c_matrix_adjugate(int n, const double* A, double* B)
     return true;
 }
 
-void c_matrix_recursive_exponentiation(int n, const double* A, double* B, int d)
+//  one of the buffers which is neither of the used ones
+double* c_matrix_free_buffer(double** buffers, const double* used1, const double* used2)
 {
-    if(d == 2)
-        return c_matrix_strassen(n, n, n, A, A, B);
-    
-    double* C = malloc(n * n * sizeof(double));
-    
-    if(d == 3)
-    {
-        c_matrix_strassen(n, n, n, A, A, C);
-        c_matrix_strassen(n, n, n, A, C, B);
-        free(C);
-        return;
-    }
+    int i = 0;
+    while(buffers[i] == used1 || buffers[i] == used2)
+        ++i;
+    return buffers[i];
+}
 
-    c_matrix_recursive_exponentiation(n, A, C, d / 2);
-    
-    if(d % 2 == 0)
+// B = A^d for d >= 1 by iterative square-and-multiply,
+// products go to B or one of two work buffers, the one not used by the operands
+void c_matrix_power(int n, const double* A, double* B, int d)
+{
+    double* buffers[3] = {B, malloc(n * n * sizeof(double)), malloc(n * n * sizeof(double))};
+    const double* square = A;
+    const double* result = NULL;
+
+    while(true)
     {
-        c_matrix_strassen(n, n, n, C, C, B);
-        free(C);
-        return;
+        if(d & 1)
+        {
+            if(result == NULL)
+                result = square;
+            else
+            {
+                double* product = c_matrix_free_buffer(buffers, result, square);
+                c_matrix_strassen(n, n, n, result, square, product);
+                result = product;
+            }
+        }
+        d >>= 1;
+        if(d == 0)
+            break;
+        double* product = c_matrix_free_buffer(buffers, result, square);
+        c_matrix_strassen(n, n, n, square, square, product);
+        square = product;
     }
-    
-    double* D = malloc(n * n * sizeof(double));
-    
-    c_matrix_strassen(n, n, n, C, C, D);
-    c_matrix_strassen(n, n, n, A, D, B);
-    free(C);
-    free(D);
+
+    if(result != B)
+        copy_d_array(n * n, result, B);
+    free(buffers[1]);
+    free(buffers[2]);
 }
 
+// B = A^d, negative powers are powers of the inverse found by one LUP decomposition
+// returns false if A is not square or it is singular for negative d
 bool c_matrix_exponentiation(int m, int n, const double* A, double* B, int d)
 {
     if(d == 1)
@@ -666,22 +674,25 @@ bool c_matrix_exponentiation(int m, int n, const double* A, double* B, int d)
 
     if(d > 0)
     {
-        c_matrix_recursive_exponentiation(n, A, B, d);
+        c_matrix_power(n, A, B, d);
         return true;
     }
 
+    double* I = malloc(n * n * sizeof(double));
+    c_matrix_shift_identity(n, I, n);
+    bool invertible;
     if(d == -1)
+        invertible = c_matrix_lup_solve(n, n, A, I, B);
+    else
     {
-        c_matrix_inverse(n, A, B);
-        return true;
+        double* C = malloc(n * n * sizeof(double));
+        invertible = c_matrix_lup_solve(n, n, A, I, C);
+        if(invertible)
+            c_matrix_power(n, C, B, -d);
+        free(C);
     }
-
-    double* C = malloc(n * n * sizeof(double));
-    c_matrix_inverse(n, A, C);
-    c_matrix_recursive_exponentiation(n, C, B, -d);
-    free(C);
-    
-    return true;
+    free(I);
+    return invertible;
 }
 
 void c_matrix_fill_range_array(int n, int* V)
@@ -735,3 +746,949 @@ void c_matrix_lup(int n, const double* A, double* LU, int* V, int* sign, bool* s
         }
     }
 }
+
+//  range [begin, end) of columns of row i which are in the part,
+//  the diagonal element is also in the range for PART_OFF_DIAGONAL
+void c_matrix_part_columns(enum matrix_part part, int m, int i, int* begin, int* end)
+{
+    *begin = 0;
+    *end = m;
+    switch(part)
+    {
+    case PART_DIAGONAL:
+        *begin = i;
+        *end = (i < m) ? i + 1 : i;
+        break;
+    case PART_LOWER:
+        *end = (i + 1 < m) ? i + 1 : m;
+        break;
+    case PART_STRICT_LOWER:
+        *end = (i < m) ? i : m;
+        break;
+    case PART_STRICT_UPPER:
+        *begin = i + 1;
+        break;
+    case PART_UPPER:
+        *begin = i;
+        break;
+    default:
+        break;
+    }
+    if(*begin > *end)
+        *begin = *end;
+}
+
+void c_matrix_row_sums(int m, int n, const double* A, double* R, enum summation method)
+{
+    for(int i = 0; i < n; ++i)
+        R[i] = sum_d_array(m, A + i * m, method);
+}
+
+#define PAIRWISE_ROWS 8
+
+//  the second half of rows is summed into T, the next m elements are a buffer for it
+void c_matrix_column_sums_pairwise(int m, int n, const double* A, double* R, double* T)
+{
+    if(n <= PAIRWISE_ROWS)
+    {
+        copy_d_array(m, A, R);
+        for(int i = 1; i < n; ++i)
+            add_d_arrays_to_first(m, R, A + i * m);
+        return;
+    }
+
+    int half = n / 2;
+    c_matrix_column_sums_pairwise(m, half, A, R, T);
+    c_matrix_column_sums_pairwise(m, n - half, A + half * m, T, T + m);
+    add_d_arrays_to_first(m, R, T);
+}
+
+//  rows are added one by one, which reads the matrix in its order
+void c_matrix_column_sums(int m, int n, const double* A, double* R, enum summation method)
+{
+    if(method == SUMMATION_PAIRWISE)
+    {
+        int levels = 1;
+        for(int k = n; k > PAIRWISE_ROWS; k = k - k / 2)
+            ++levels;
+        double* T = malloc(m * levels * sizeof(double));
+        c_matrix_column_sums_pairwise(m, n, A, R, T);
+        free(T);
+        return;
+    }
+
+    double* compensation = malloc(m * sizeof(double));
+    fill_d_array(m, R, 0);
+    fill_d_array(m, compensation, 0);
+    for(int i = 0; i < n; ++i)
+    {
+        const double* row = A + i * m;
+        for(int j = 0; j < m; ++j)
+        {
+            double t = R[j] + row[j];
+            if(fabs(R[j]) >= fabs(row[j]))
+                compensation[j] += (R[j] - t) + row[j];
+            else
+                compensation[j] += (row[j] - t) + R[j];
+            R[j] = t;
+        }
+    }
+    add_d_arrays_to_first(m, R, compensation);
+    free(compensation);
+}
+
+void c_matrix_row_extremum(int m, int n, const double* A, double* R, bool max)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        const double* row = A + i * m;
+        R[i] = row[max ? argmax_d_array(m, row) : argmin_d_array(m, row)];
+    }
+}
+
+void c_matrix_column_extremum(int m, int n, const double* A, double* R, bool max)
+{
+    copy_d_array(m, A, R);
+    for(int i = 1; i < n; ++i)
+    {
+        const double* row = A + i * m;
+        for(int j = 0; j < m; ++j)
+            if(max ? row[j] > R[j] : row[j] < R[j])
+                R[j] = row[j];
+    }
+}
+
+//  maximum absolute column sum
+double c_matrix_norm_1(int m, int n, const double* A)
+{
+    double* sums = malloc(m * sizeof(double));
+    abs_d_array(m, A, sums);
+    for(int i = 1; i < n; ++i)
+    {
+        const double* row = A + i * m;
+        for(int j = 0; j < m; ++j)
+            sums[j] += fabs(row[j]);
+    }
+    double norm = abs_max_d_array(m, sums);
+    free(sums);
+    return norm;
+}
+
+//  maximum absolute row sum
+double c_matrix_norm_inf(int m, int n, const double* A)
+{
+    double norm = 0;
+    for(int i = 0; i < n; ++i)
+    {
+        double sum = abs_sum_d_array(m, A + i * m);
+        if(sum > norm)
+            norm = sum;
+    }
+    return norm;
+}
+
+//  flags of enum matrix_structure for the matrix n x n,
+//  each check stops at the first element that breaks it
+int c_matrix_analyze(int n, const double* A)
+{
+    int flags = MATRIX_DIAGONAL | MATRIX_LOWER | MATRIX_UPPER | MATRIX_SYMMETRIC;
+    for(int i = 0; i < n && flags != 0; ++i)
+    {
+        const double* line = A + i * n;
+        if(flags & MATRIX_UPPER)
+            for(int j = 0; j < i; ++j)
+                if(line[j] != 0)
+                {
+                    flags &= ~(MATRIX_DIAGONAL | MATRIX_UPPER);
+                    break;
+                }
+        if(flags & MATRIX_LOWER)
+            for(int j = i + 1; j < n; ++j)
+                if(line[j] != 0)
+                {
+                    flags &= ~(MATRIX_DIAGONAL | MATRIX_LOWER);
+                    break;
+                }
+        if(flags & MATRIX_SYMMETRIC)
+            for(int j = i + 1; j < n; ++j)
+                if(line[j] != A[i + j * n])
+                {
+                    flags &= ~MATRIX_SYMMETRIC;
+                    break;
+                }
+    }
+    if(c_matrix_permutation(n, A))
+        flags |= MATRIX_PERMUTATION;
+    return flags | MATRIX_ANALYZED;
+}
+
+// A - diagonal matrix n x n
+// B - matrix m x n
+// C = A * B
+void c_matrix_diagonal_multiply(int n, int m, const double* A, const double* B, double* C)
+{
+    for(int i = 0; i < n; ++i)
+        multiply_d_array_to_result(m, B + i * m, A[i * (n + 1)], C + i * m);
+}
+
+// B - matrix n x k
+// A - diagonal matrix n x n
+// C = B * A
+void c_matrix_multiply_diagonal(int k, int n, const double* B, const double* A, double* C)
+{
+    for(int i = 0; i < k; ++i)
+    {
+        const double* p_b = B + i * n;
+        double* p_c = C + i * n;
+        for(int j = 0; j < n; ++j)
+            p_c[j] = p_b[j] * A[j * (n + 1)];
+    }
+}
+
+// A - lower or upper triangular matrix n x n
+// B - matrix m x n
+// C = A * B, zero half of A is skipped
+void c_matrix_triangular_multiply(int n, int m, const double* A, const double* B, double* C, bool lower)
+{
+    fill_d_array(m * n, C, 0);
+    for(int i = 0; i < n; ++i)
+    {
+        const double* p_a = A + i * n;
+        double* p_c = C + i * m;
+        int begin = lower ? 0 : i;
+        int end = lower ? i + 1 : n;
+        for(int t = begin; t < end; ++t)
+        {
+            double d_a = p_a[t];
+            if(d_a == 0)
+                continue;
+            const double* p_b = B + t * m;
+            for(int j = 0; j < m; ++j)
+                p_c[j] += d_a * p_b[j];
+        }
+    }
+}
+
+// B - matrix n x k
+// A - lower or upper triangular matrix n x n
+// C = B * A, zero half of A is skipped
+void c_matrix_multiply_triangular(int k, int n, const double* B, const double* A, double* C, bool lower)
+{
+    fill_d_array(k * n, C, 0);
+    for(int i = 0; i < k; ++i)
+    {
+        const double* p_b = B + i * n;
+        double* p_c = C + i * n;
+        for(int t = 0; t < n; ++t)
+        {
+            double d_b = p_b[t];
+            if(d_b == 0)
+                continue;
+            const double* p_a = A + t * n;
+            int begin = lower ? 0 : t;
+            int end = lower ? t + 1 : n;
+            for(int j = begin; j < end; ++j)
+                p_c[j] += d_b * p_a[j];
+        }
+    }
+}
+
+// P[i] - column of the unit in the row i of the permutation matrix A n x n
+void c_matrix_permutation_indices(int n, const double* A, int* P)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        const double* line = A + i * n;
+        int j = 0;
+        while(line[j] == 0)
+            ++j;
+        P[i] = j;
+    }
+}
+
+// B - matrix m x n
+// C = P * B, row i of C is row P[i] of B,
+// or C = P^T * B with inverse, row P[i] of C is row i of B
+void c_matrix_permute_rows(int n, int m, const int* P, const double* B, double* C, bool inverse)
+{
+    for(int i = 0; i < n; ++i)
+        if(inverse)
+            copy_d_array(m, B + i * m, C + P[i] * m);
+        else
+            copy_d_array(m, B + P[i] * m, C + i * m);
+}
+
+// B - matrix n x k
+// C = B * P, column P[j] of C is column j of B
+void c_matrix_permute_columns(int k, int n, const int* P, const double* B, double* C)
+{
+    for(int i = 0; i < k; ++i)
+    {
+        const double* p_b = B + i * n;
+        double* p_c = C + i * n;
+        for(int j = 0; j < n; ++j)
+            p_c[P[j]] = p_b[j];
+    }
+}
+
+// solves A * X = B in place of B
+// A - lower or upper triangular matrix n x n
+// B - matrix m x n
+// returns false if A is singular
+bool c_matrix_triangular_solve(int n, int m, const double* A, double* B, bool lower)
+{
+    for(int i = 0; i < n; ++i)
+        if(A[i * (n + 1)] == 0)
+            return false;
+
+    for(int s = 0; s < n; ++s)
+    {
+        int i = lower ? s : n - 1 - s;
+        const double* p_a = A + i * n;
+        double* line = B + i * m;
+        int begin = lower ? 0 : i + 1;
+        int end = lower ? i : n;
+        for(int t = begin; t < end; ++t)
+        {
+            double mul = p_a[t];
+            if(mul == 0)
+                continue;
+            const double* solved = B + t * m;
+            for(int j = 0; j < m; ++j)
+                line[j] -= mul * solved[j];
+        }
+        multiply_d_array(m, line, 1 / p_a[i]);
+    }
+    return true;
+}
+
+// solves A * X = B with the LUP decomposition of A
+// A - matrix n x n
+// B, X - matrices m x n
+// returns false if A is singular
+bool c_matrix_lup_solve(int n, int m, const double* A, const double* B, double* X)
+{
+    double* LU = malloc(n * n * sizeof(double));
+    int* permutation = malloc(n * sizeof(int));
+    int sign;
+    bool singular;
+    c_matrix_lup(n, A, LU, permutation, &sign, &singular);
+    if(!singular)
+        c_lup_solve(m, n, LU, B, permutation, X);
+    free(LU);
+    free(permutation);
+    return !singular;
+}
+
+// Cholesky decomposition A = L * L^T of a symmetric matrix A n x n
+// returns false if A is not positive definite
+bool c_matrix_cholesky(int n, const double* A, double* L)
+{
+    fill_d_array(n * n, L, 0);
+    for(int i = 0; i < n; ++i)
+    {
+        double* l_line = L + i * n;
+        for(int j = 0; j < i; ++j)
+        {
+            const double* l_j = L + j * n;
+            l_line[j] = (A[i * n + j] - dot_d_arrays(j, l_line, l_j)) / l_j[j];
+        }
+        double d = A[i * n + i] - dot_d_arrays(i, l_line, l_line);
+        if(d <= 0)
+            return false;
+        l_line[i] = sqrt(d);
+    }
+    return true;
+}
+
+// solves L * L^T * X = B in place, B - matrix m x n
+void c_matrix_cholesky_solve(int n, int m, const double* L, double* B)
+{
+    c_matrix_triangular_solve(n, m, L, B, true);
+    for(int i = n - 1; i >= 0; --i)
+    {
+        double* line = B + i * m;
+        for(int t = i + 1; t < n; ++t)
+        {
+            double mul = L[t * n + i];
+            if(mul != 0)
+                add_scaled_d_array_to_first(m, line, -mul, B + t * m);
+        }
+        multiply_d_array(m, line, 1 / L[i * (n + 1)]);
+    }
+}
+
+// R = B - A * X accumulated in extended precision
+// A - matrix n x n
+// B, X, R - matrices m x n
+void c_matrix_residual(int n, int m, const double* A, const double* B, const double* X, double* R)
+{
+    long double* sum = malloc(m * sizeof(long double));
+    for(int i = 0; i < n; ++i)
+    {
+        const double* a_line = A + i * n;
+        for(int j = 0; j < m; ++j)
+            sum[j] = B[i * m + j];
+        for(int t = 0; t < n; ++t)
+        {
+            long double mul = a_line[t];
+            if(mul == 0)
+                continue;
+            const double* x_line = X + t * m;
+            for(int j = 0; j < m; ++j)
+                sum[j] -= mul * x_line[j];
+        }
+        for(int j = 0; j < m; ++j)
+            R[i * m + j] = sum[j];
+    }
+    free(sum);
+}
+
+// chooses the cheapest method for A n x n with flags structure of enum matrix_structure
+// returns false if A is singular, nothing has to be freed then
+bool c_matrix_solver_init(struct matrix_solver* S, int n, const double* A, int structure)
+{
+    S->n = n;
+    S->factor = A;
+    S->owned = NULL;
+    S->permutation = NULL;
+
+    if(structure & MATRIX_DIAGONAL)
+    {
+        S->method = MATRIX_DIAGONAL;
+        for(int i = 0; i < n; ++i)
+            if(A[i * (n + 1)] == 0)
+                return false;
+        return true;
+    }
+    if(structure & MATRIX_PERMUTATION)
+    {
+        S->method = MATRIX_PERMUTATION;
+        S->permutation = malloc(n * sizeof(int));
+        c_matrix_permutation_indices(n, A, S->permutation);
+        return true;
+    }
+    if(structure & (MATRIX_LOWER | MATRIX_UPPER))
+    {
+        S->method = structure & MATRIX_LOWER ? MATRIX_LOWER : MATRIX_UPPER;
+        for(int i = 0; i < n; ++i)
+            if(A[i * (n + 1)] == 0)
+                return false;
+        return true;
+    }
+
+    S->owned = malloc(n * n * sizeof(double));
+    S->factor = S->owned;
+    if(structure & MATRIX_SYMMETRIC)
+    {
+        S->method = MATRIX_SYMMETRIC;
+        if(c_matrix_cholesky(n, A, S->owned))
+            return true;
+    }
+
+    S->method = 0;
+    S->permutation = malloc(n * sizeof(int));
+    int sign;
+    bool singular;
+    c_matrix_lup(n, A, S->owned, S->permutation, &sign, &singular);
+    if(singular)
+        c_matrix_solver_free(S);
+    return !singular;
+}
+
+// X = A^-1 * B, B and X are different matrices m x n
+void c_matrix_solver_apply(const struct matrix_solver* S, int m, const double* B, double* X)
+{
+    int n = S->n;
+    switch(S->method)
+    {
+    case MATRIX_DIAGONAL:
+        for(int i = 0; i < n; ++i)
+            multiply_d_array_to_result(m, B + i * m, 1 / S->factor[i * (n + 1)], X + i * m);
+        break;
+    case MATRIX_PERMUTATION:
+        c_matrix_permute_rows(n, m, S->permutation, B, X, true);
+        break;
+    case MATRIX_LOWER:
+    case MATRIX_UPPER:
+        copy_d_array(m * n, B, X);
+        c_matrix_triangular_solve(n, m, S->factor, X, S->method == MATRIX_LOWER);
+        break;
+    case MATRIX_SYMMETRIC:
+        copy_d_array(m * n, B, X);
+        c_matrix_cholesky_solve(n, m, S->factor, X);
+        break;
+    default:
+        c_lup_solve(m, n, S->factor, B, S->permutation, X);
+    }
+}
+
+// iterative refinement of the solution X of A * X = B with residuals in extended precision,
+// stops when the correction is below the rounding of X or does not halve
+void c_matrix_solver_refine(const struct matrix_solver* S, const double* A, int m, const double* B, double* X)
+{
+    int size = m * S->n;
+    double* R = malloc(2 * size * sizeof(double));
+    double* D = R + size;
+    double previous = INFINITY;
+
+    for(int step = 0; step < MATRIX_REFINE_STEPS; ++step)
+    {
+        c_matrix_residual(S->n, m, A, B, X, R);
+        c_matrix_solver_apply(S, m, R, D);
+        double correction = abs_max_d_array(size, D);
+        if(correction >= previous / 2)
+            break;
+        add_d_arrays_to_first(size, X, D);
+        if(correction <= DBL_EPSILON * abs_max_d_array(size, X))
+            break;
+        previous = correction;
+    }
+    free(R);
+}
+
+void c_matrix_solver_free(struct matrix_solver* S)
+{
+    free(S->owned);
+    free(S->permutation);
+}
+
+//  determinant of a triangular matrix n x n
+double c_matrix_diagonal_product(int n, const double* A)
+{
+    double res = 1;
+    for(int i = 0; i < n; ++i)
+        res *= A[i * (n + 1)];
+    return res;
+}
+
+//  determinant of the permutation matrix with indices P
+double c_matrix_permutation_sign(int n, const int* P)
+{
+    bool* visited = malloc(n * sizeof(bool));
+    for(int i = 0; i < n; ++i)
+        visited[i] = false;
+
+    double sign = 1;
+    for(int i = 0; i < n; ++i)
+    {
+        if(visited[i])
+            continue;
+        int length = 0;
+        for(int j = i; !visited[j]; j = P[j])
+        {
+            visited[j] = true;
+            ++length;
+        }
+        if(length % 2 == 0)
+            sign = -sign;
+    }
+    free(visited);
+    return sign;
+}
+
+// tiles of the products A * A^T and A^T * A are compared as soon as they are
+// computed, GRAM_TILE x GRAM_TILE accumulators fit on the stack
+#define GRAM_TILE 16
+
+int gram_tile_end(int begin, int n)
+{
+    return (begin + GRAM_TILE < n) ? begin + GRAM_TILE : n;
+}
+
+// checks A * A^T = I up to the tolerance without computing the product
+// A - matrix m x n
+bool c_matrix_orthonormal_rows(int m, int n, const double* A, double tolerance)
+{
+    for(int bi = 0; bi < n; bi += GRAM_TILE)
+        for(int bj = bi; bj < n; bj += GRAM_TILE)
+        {
+            int ei = gram_tile_end(bi, n);
+            int ej = gram_tile_end(bj, n);
+            for(int i = bi; i < ei; ++i)
+                for(int j = (bj > i) ? bj : i; j < ej; ++j)
+                {
+                    double expected = (i == j) ? 1 : 0;
+                    // negated, so NaN elements fail the check
+                    if(!(fabs(dot_d_arrays(m, A + i * m, A + j * m) - expected) <= tolerance))
+                        return false;
+                }
+        }
+    return true;
+}
+
+// checks A * A^T = A^T * A up to the tolerance without computing the products
+// A - matrix n x n
+bool c_matrix_normal(int n, const double* A, double tolerance)
+{
+    double columns[GRAM_TILE * GRAM_TILE];
+    for(int bi = 0; bi < n; bi += GRAM_TILE)
+        for(int bj = bi; bj < n; bj += GRAM_TILE)
+        {
+            int ei = gram_tile_end(bi, n);
+            int ej = gram_tile_end(bj, n);
+
+            // tile of A^T * A, products of columns are accumulated row by row
+            fill_d_array(GRAM_TILE * GRAM_TILE, columns, 0);
+            for(int k = 0; k < n; ++k)
+            {
+                const double* line = A + k * n;
+                for(int i = bi; i < ei; ++i)
+                {
+                    double d = line[i];
+                    if(d == 0)
+                        continue;
+                    double* acc = columns + (i - bi) * GRAM_TILE;
+                    for(int j = bj; j < ej; ++j)
+                        acc[j - bj] += d * line[j];
+                }
+            }
+
+            for(int i = bi; i < ei; ++i)
+                for(int j = (bj > i) ? bj : i; j < ej; ++j)
+                {
+                    double rows = dot_d_arrays(n, A + i * n, A + j * n);
+                    if(!(fabs(rows - columns[(i - bi) * GRAM_TILE + j - bj]) <= tolerance))
+                        return false;
+                }
+        }
+    return true;
+}
+
+// rows of A added to the lower triangle of A^T * A before moving to the next
+// row of the result, so the row of the result stays in the cache
+#define SYRK_ROWS 64
+
+//  row i of the lower triangle of the result of size n x n
+double* syrk_row(int n, double* C, int i, bool packed)
+{
+    return C + (packed ? i * (i + 1) / 2 : i * n);
+}
+
+// A - matrix m x n
+// C = A^T * A (m x m) if trans, C = A * A^T (n x n) otherwise,
+// only the lower triangle is computed, it is packed by rows or mirrored to the upper one
+void c_matrix_syrk(int m, int n, const double* A, double* C, bool trans, bool packed)
+{
+    int size = trans ? m : n;
+    if(trans)
+    {
+        for(int i = 0; i < m; ++i)
+            fill_d_array(i + 1, syrk_row(m, C, i, packed), 0);
+
+        for(int kb = 0; kb < n; kb += SYRK_ROWS)
+        {
+            int ke = (kb + SYRK_ROWS < n) ? kb + SYRK_ROWS : n;
+            for(int i = 0; i < m; ++i)
+            {
+                double* p_c = syrk_row(m, C, i, packed);
+                for(int k = kb; k < ke; ++k)
+                {
+                    const double* line = A + k * m;
+                    double d = line[i];
+                    if(d == 0)
+                        continue;
+                    for(int j = 0; j <= i; ++j)
+                        p_c[j] += d * line[j];
+                }
+            }
+        }
+    }
+    else
+        for(int bi = 0; bi < n; bi += GRAM_TILE)
+            for(int bj = 0; bj <= bi; bj += GRAM_TILE)
+            {
+                int ei = gram_tile_end(bi, n);
+                int ej = gram_tile_end(bj, n);
+                for(int i = bi; i < ei; ++i)
+                {
+                    double* p_c = syrk_row(n, C, i, packed);
+                    for(int j = bj; j < ej && j <= i; ++j)
+                        p_c[j] = dot_d_arrays(m, A + i * m, A + j * m);
+                }
+            }
+
+    if(!packed)
+        for(int i = 0; i < size; ++i)
+            for(int j = 0; j < i; ++j)
+                C[j * size + i] = C[i * size + j];
+}
+
+// A = A + alpha * U * V^T
+// A - matrix m x n
+// U - vector n
+// V - vector m
+void c_matrix_rank1_update(int m, int n, double* A, double alpha, const double* U, const double* V)
+{
+    for(int i = 0; i < n; ++i)
+    {
+        double d = alpha * U[i];
+        if(d != 0)
+            add_scaled_d_array_to_first(m, A + i * m, d, V);
+    }
+}
+
+// Sherman-Morrison formula, B = A^-1 n x n becomes (A + u * v^T)^-1
+// returns false if A + u * v^T is singular, B is not changed then
+bool c_matrix_sherman_morrison(int n, double* B, const double* U, const double* V)
+{
+    double* w = malloc(2 * n * sizeof(double));
+    double* z = w + n;
+
+    fill_d_array(n, z, 0);
+    for(int i = 0; i < n; ++i)
+    {
+        w[i] = dot_d_arrays(n, B + i * n, U);
+        if(V[i] != 0)
+            add_scaled_d_array_to_first(n, z, V[i], B + i * n);
+    }
+
+    double denominator = 1 + dot_d_arrays(n, V, w);
+    bool regular = denominator != 0;
+    if(regular)
+        c_matrix_rank1_update(n, n, B, -1 / denominator, w, z);
+    free(w);
+    return regular;
+}
+
+// R[i] = |A[i]|^2 for rows of A m x n
+void c_matrix_row_squared_norms(int m, int n, const double* A, double* R)
+{
+    for(int i = 0; i < n; ++i)
+        R[i] = dot_d_arrays(m, A + i * m, A + i * m);
+}
+
+// metric between rows of A k x n and rows of B by |a|^2 + |b|^2 - 2 a * b^T,
+// so the block costs one product A * BT
+// BT      - matrix m x k, transposed B
+// a_norms - squared norms of rows of A
+// b_norms - squared norms of rows of B
+// R       - matrix m x n
+void c_matrix_pairwise_block(int n, int k, int m, const double* A, const double* a_norms,
+    const double* BT, const double* b_norms, enum pairwise_metric metric, double* R)
+{
+    c_matrix_strassen(n, k, m, A, BT, R);
+    for(int i = 0; i < n; ++i)
+    {
+        double* line = R + i * m;
+        double a = a_norms[i];
+        if(metric == PAIRWISE_EUCLIDEAN || metric == PAIRWISE_SQEUCLIDEAN)
+        {
+            // rounding may leave small negative squares for close rows
+            for(int j = 0; j < m; ++j)
+                line[j] = fmax(a + b_norms[j] - 2 * line[j], 0);
+            if(metric == PAIRWISE_EUCLIDEAN)
+                for(int j = 0; j < m; ++j)
+                    line[j] = sqrt(line[j]);
+            continue;
+        }
+
+        // zero rows are not similar to anything
+        for(int j = 0; j < m; ++j)
+        {
+            double norm = sqrt(a * b_norms[j]);
+            line[j] = norm == 0 ? 0 : line[j] / norm;
+        }
+        if(metric == PAIRWISE_COSINE)
+            for(int j = 0; j < m; ++j)
+                line[j] = 1 - line[j];
+    }
+}
+
+// k smallest or largest elements of V n in order to R k and their indices to I k, k <= n
+void c_matrix_top_k(int n, const double* V, int k, bool largest, double* R, int* I)
+{
+    double sign = largest ? -1 : 1;
+    int size = 0;
+    for(int j = 0; j < n; ++j)
+    {
+        double v = sign * V[j];
+        if(size == k && v >= R[k - 1])
+            continue;
+        int p = size < k ? size++ : k - 1;
+        for(; p > 0 && R[p - 1] > v; --p)
+        {
+            R[p] = R[p - 1];
+            I[p] = I[p - 1];
+        }
+        R[p] = v;
+        I[p] = j;
+    }
+    multiply_d_array(k, R, sign);
+}
+
+// optimal order of the product of count matrices by dynamic programming
+// dims  - matrix i has dims[i] rows and dims[i + 1] columns
+// split - split[i * count + j] is the last matrix of the left factor in the product of matrices i..j
+void c_matrix_chain_order(int count, const int* dims, int* split)
+{
+    double* cost = malloc(count * count * sizeof(double));
+    for(int i = 0; i < count; ++i)
+        cost[i * count + i] = 0;
+
+    for(int len = 2; len <= count; ++len)
+        for(int i = 0; i + len <= count; ++i)
+        {
+            int j = i + len - 1;
+            double best = -1;
+            for(int k = i; k < j; ++k)
+            {
+                double c = cost[i * count + k] + cost[(k + 1) * count + j]
+                    + (double)dims[i] * dims[k + 1] * dims[j + 1];
+                if(best < 0 || c < best)
+                {
+                    best = c;
+                    split[i * count + j] = k;
+                }
+            }
+            cost[i * count + j] = best;
+        }
+    free(cost);
+}
+
+// R - product of the matrices first..last (first < last) in the order of c_matrix_chain_order,
+// only the intermediate products are allocated, each is freed as soon as it is used
+void c_matrix_chain_multiply(int count, const int* dims, const int* split, const double* const* operands,
+    int first, int last, double* R)
+{
+    int k = split[first * count + last];
+    double* left = NULL;
+    double* right = NULL;
+    if(k > first)
+    {
+        left = malloc(dims[first] * dims[k + 1] * sizeof(double));
+        c_matrix_chain_multiply(count, dims, split, operands, first, k, left);
+    }
+    if(k + 1 < last)
+    {
+        right = malloc(dims[k + 1] * dims[last + 1] * sizeof(double));
+        c_matrix_chain_multiply(count, dims, split, operands, k + 1, last, right);
+    }
+
+    fill_d_array(dims[first] * dims[last + 1], R, 0);
+    c_matrix_strassen(dims[first], dims[k + 1], dims[last + 1],
+        left ? left : operands[first], right ? right : operands[last], R);
+    free(left);
+    free(right);
+}
+
+// coefficients of the numerators of the Pade approximants of degrees 3, 5, 7, 9 and 13
+// and the largest 1-norms for which they are accurate in double precision (Higham, 2005)
+static const double expm_pade3[] = {120, 60, 12, 1};
+static const double expm_pade5[] = {30240, 15120, 3360, 420, 30, 1};
+static const double expm_pade7[] = {17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1};
+static const double expm_pade9[] = {17643225600., 8821612800., 2075673600., 302702400., 30270240.,
+    2162160., 110880., 3960., 90., 1.};
+static const double expm_pade13[] = {64764752532480000., 32382376266240000., 7771770303897600.,
+    1187353796428800., 129060195264000., 10559470521600., 670442572800., 33522128640.,
+    1323241920., 40840800., 960960., 16380., 182., 1.};
+static const double expm_theta[] = {1.495585217958292e-2, 2.539398330063230e-1,
+    9.504178996162932e-1, 2.097847961257068e0, 5.371920351148152e0};
+
+// U = A * sum of b[2j + 1] * A^2j, V = sum of b[2j] * A^2j, powers[j] = A^2j for j <= degree / 2
+void c_matrix_expm_pade(int n, const double* A, const double* const* powers, const double* b, int degree,
+    double* U, double* V, double* T)
+{
+    int len = n * n;
+    fill_d_array(len, T, 0);
+    fill_d_array(len, V, 0);
+    for(int j = 0; 2 * j <= degree; ++j)
+    {
+        add_scaled_d_array_to_first(len, T, b[2 * j + 1], powers[j]);
+        add_scaled_d_array_to_first(len, V, b[2 * j], powers[j]);
+    }
+    c_matrix_strassen(n, n, n, A, T, U);
+}
+
+// U and V of the degree 13, the high powers are combined through A^6 as in Higham's algorithm
+void c_matrix_expm_pade13(int n, const double* A, const double* const* powers,
+    double* U, double* V, double* T)
+{
+    const double* b = expm_pade13;
+    int len = n * n;
+    double* S = malloc(len * sizeof(double));
+
+    // T = A^6 * (b13 A^6 + b11 A^4 + b9 A^2) + b7 A^6 + b5 A^4 + b3 A^2 + b1 I
+    fill_d_array(len, S, 0);
+    for(int j = 1; j <= 3; ++j)
+        add_scaled_d_array_to_first(len, S, b[2 * j + 7], powers[j]);
+    c_matrix_strassen(n, n, n, powers[3], S, T);
+    for(int j = 0; j <= 3; ++j)
+        add_scaled_d_array_to_first(len, T, b[2 * j + 1], powers[j]);
+    c_matrix_strassen(n, n, n, A, T, U);
+
+    // V = A^6 * (b12 A^6 + b10 A^4 + b8 A^2) + b6 A^6 + b4 A^4 + b2 A^2 + b0 I
+    fill_d_array(len, S, 0);
+    for(int j = 1; j <= 3; ++j)
+        add_scaled_d_array_to_first(len, S, b[2 * j + 6], powers[j]);
+    c_matrix_strassen(n, n, n, powers[3], S, V);
+    for(int j = 0; j <= 3; ++j)
+        add_scaled_d_array_to_first(len, V, b[2 * j], powers[j]);
+    free(S);
+}
+
+// E = exp(A) by scaling and squaring with the Pade approximant of the smallest sufficient degree
+// A - matrix n x n
+// returns false if the denominator of the approximant is singular
+bool c_matrix_expm(int n, const double* A, double* E)
+{
+    int len = n * n;
+    double norm = c_matrix_norm_1(n, n, A);
+    const double* coefficients[] = {expm_pade3, expm_pade5, expm_pade7, expm_pade9};
+    int degree = 13;
+    int squarings = 0;
+    for(int i = 0; i < 4; ++i)
+        if(norm <= expm_theta[i])
+        {
+            degree = 2 * i + 3;
+            break;
+        }
+    if(degree == 13 && norm > expm_theta[4])
+        squarings = (int)ceil(log2(norm / expm_theta[4]));
+
+    // powers of the scaled matrix: I, A^2, A^4, A^6, A^8
+    double* S = malloc(len * sizeof(double));
+    multiply_d_array_to_result(len, A, ldexp(1, -squarings), S);
+    double* powers[5];
+    int count = (degree == 13) ? 4 : degree / 2 + 1;
+    powers[0] = malloc(len * sizeof(double));
+    c_matrix_shift_identity(n, powers[0], n);
+    for(int j = 1; j < count; ++j)
+    {
+        powers[j] = malloc(len * sizeof(double));
+        c_matrix_strassen(n, n, n, (j == 1) ? S : powers[j - 1], (j == 1) ? S : powers[1], powers[j]);
+    }
+
+    double* U = malloc(len * sizeof(double));
+    double* V = malloc(len * sizeof(double));
+    double* T = malloc(len * sizeof(double));
+    if(degree == 13)
+        c_matrix_expm_pade13(n, S, (const double* const*)powers, U, V, T);
+    else
+        c_matrix_expm_pade(n, S, (const double* const*)powers, coefficients[degree / 2 - 1], degree, U, V, T);
+
+    // (V - U) * E = V + U
+    add_d_arrays_to_result(len, V, U, T);
+    sub_d_arrays_to_first(len, V, U);
+    bool solved = c_matrix_lup_solve(n, n, V, T, E);
+
+    // squarings alternate between E and T
+    double* current = E;
+    double* next = T;
+    for(int i = 0; solved && i < squarings; ++i)
+    {
+        c_matrix_strassen(n, n, n, current, current, next);
+        next = current;
+        current = (next == E) ? T : E;
+    }
+    if(current != E)
+        copy_d_array(len, current, E);
+
+    for(int j = 0; j < count; ++j)
+        free(powers[j]);
+    free(S);
+    free(U);
+    free(V);
+    free(T);
+    return solved;
+}
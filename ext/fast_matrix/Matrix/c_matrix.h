@@ -2,6 +2,7 @@
 #define FAST_MATRIX_MATRIX_C_MATRIX_H 1
 
 #include <stdbool.h>
+#include "Helper/c_array_operations.h"
 
 // matrix
 //     m --->
@@ -16,8 +17,62 @@ struct matrix
     int n;
 
     double* data;
+    // owners of data, NULL if data is owned only by this one
+    struct shared_d_array* shared;
+    // number of exported memory views
+    int views;
 
     bool frozen;
+    // flags of enum matrix_structure, 0 until the matrix is analyzed
+    int structure;
+};
+
+// structure of a square matrix found by c_matrix_analyze
+enum matrix_structure
+{
+    MATRIX_ANALYZED = 1,
+    MATRIX_DIAGONAL = 2,
+    MATRIX_LOWER = 4,
+    MATRIX_UPPER = 8,
+    MATRIX_SYMMETRIC = 16,
+    MATRIX_PERMUTATION = 32,
+};
+
+// limit of steps of the iterative refinement in c_matrix_solver_refine
+#define MATRIX_REFINE_STEPS 10
+
+// factorization of a square matrix chosen by its structure for solving systems
+struct matrix_solver
+{
+    int n;
+    // MATRIX_DIAGONAL, MATRIX_PERMUTATION, MATRIX_LOWER, MATRIX_UPPER,
+    // MATRIX_SYMMETRIC for the Cholesky factor or 0 for the LUP decomposition
+    int method;
+    // the matrix itself for the structured methods, owned factors otherwise
+    const double* factor;
+    double* owned;
+    int* permutation;
+};
+
+// parts of a matrix for Matrix#each
+enum matrix_part
+{
+    PART_ALL,
+    PART_DIAGONAL,
+    PART_OFF_DIAGONAL,
+    PART_LOWER,
+    PART_STRICT_LOWER,
+    PART_STRICT_UPPER,
+    PART_UPPER
+};
+
+// metrics between rows of two matrices for c_matrix_pairwise_block
+enum pairwise_metric
+{
+    PAIRWISE_EUCLIDEAN,
+    PAIRWISE_SQEUCLIDEAN,
+    PAIRWISE_COSINE,
+    PAIRWISE_SIMILARITY
 };
 
 double c_matrix_trace(int n, const double* A);
@@ -33,6 +88,28 @@ void c_matrix_scalar(int n, double* C, double v);
 void c_matrix_minor(int m, int n, const double* A, double* B, int m_idx, int n_idx);
 void c_matrix_vstack(int argc, struct matrix** mtrs, double* C);
 void c_matrix_lup(int n, const double* A, double* LU, int* V, int* sign, bool* singular);
+void c_matrix_part_columns(enum matrix_part part, int m, int i, int* begin, int* end);
+void c_matrix_row_sums(int m, int n, const double* A, double* R, enum summation method);
+void c_matrix_column_sums(int m, int n, const double* A, double* R, enum summation method);
+void c_matrix_row_extremum(int m, int n, const double* A, double* R, bool max);
+void c_matrix_column_extremum(int m, int n, const double* A, double* R, bool max);
+void c_matrix_diagonal_multiply(int n, int m, const double* A, const double* B, double* C);
+void c_matrix_multiply_diagonal(int k, int n, const double* B, const double* A, double* C);
+void c_matrix_triangular_multiply(int n, int m, const double* A, const double* B, double* C, bool lower);
+void c_matrix_multiply_triangular(int k, int n, const double* B, const double* A, double* C, bool lower);
+void c_matrix_permutation_indices(int n, const double* A, int* P);
+void c_matrix_permute_rows(int n, int m, const int* P, const double* B, double* C, bool inverse);
+void c_matrix_permute_columns(int k, int n, const int* P, const double* B, double* C);
+void c_matrix_rank1_update(int m, int n, double* A, double alpha, const double* U, const double* V);
+bool c_matrix_sherman_morrison(int n, double* B, const double* U, const double* V);
+void c_matrix_chain_order(int count, const int* dims, int* split);
+void c_matrix_chain_multiply(int count, const int* dims, const int* split, const double* const* operands,
+    int first, int last, double* R);
+void c_matrix_syrk(int m, int n, const double* A, double* C, bool trans, bool packed);
+void c_matrix_row_squared_norms(int m, int n, const double* A, double* R);
+void c_matrix_pairwise_block(int n, int k, int m, const double* A, const double* a_norms,
+    const double* BT, const double* b_norms, enum pairwise_metric metric, double* R);
+void c_matrix_top_k(int n, const double* V, int k, bool largest, double* R, int* I);
 
 bool c_matrix_symmetric(int n, const double* C);
 bool c_matrix_antisymmetric(int n, const double* C);
@@ -46,9 +123,27 @@ bool c_matrix_equal_by_n(int argc, struct matrix** mtrs);
 bool c_matrix_inverse(int n, const double* A, double* B);
 bool c_matrix_adjugate(int n, const double* A, double* B);
 bool c_matrix_exponentiation(int m, int n, const double* A, double* B, int d);
+bool c_matrix_expm(int n, const double* A, double* E);
+bool c_matrix_triangular_solve(int n, int m, const double* A, double* B, bool lower);
+bool c_matrix_lup_solve(int n, int m, const double* A, const double* B, double* X);
+bool c_matrix_cholesky(int n, const double* A, double* L);
+void c_matrix_cholesky_solve(int n, int m, const double* L, double* B);
+void c_matrix_residual(int n, int m, const double* A, const double* B, const double* X, double* R);
+bool c_matrix_solver_init(struct matrix_solver* S, int n, const double* A, int structure);
+void c_matrix_solver_apply(const struct matrix_solver* S, int m, const double* B, double* X);
+void c_matrix_solver_refine(const struct matrix_solver* S, const double* A, int m, const double* B, double* X);
+void c_matrix_solver_free(struct matrix_solver* S);
+bool c_matrix_orthonormal_rows(int m, int n, const double* A, double tolerance);
+bool c_matrix_normal(int n, const double* A, double tolerance);
 
 int c_matrix_sum_by_m(int argc, struct matrix** mtrs);
 int c_matrix_sum_by_n(int argc, struct matrix** mtrs);
 int c_matrix_rank(int m, int n, const double* C);
+int c_matrix_analyze(int n, const double* A);
+
+double c_matrix_norm_1(int m, int n, const double* A);
+double c_matrix_norm_inf(int m, int n, const double* A);
+double c_matrix_diagonal_product(int n, const double* A);
+double c_matrix_permutation_sign(int n, const int* P);
 
 #endif /* FAST_MATRIX_MATRIX_C_MATRIX_H */
@@ -3,6 +3,7 @@
 
 #include "ruby.h"
 #include "Matrix/c_matrix.h"
+#include "Helper/c_array_operations.h"
 
 inline struct matrix* get_matrix_from_rb_value(VALUE m)
 {
@@ -16,6 +17,17 @@ inline void c_matrix_init(struct matrix* mtr, int m, int n)
     mtr->m = m;
     mtr->n = n;
     mtr->data = malloc(m * n * sizeof(double));
+    mtr->shared = NULL;
+    mtr->views = 0;
+    mtr->structure = 0;
+}
+
+//  copy data of the cloned matrix before the first modification,
+//  the cached structure is reset because every writer calls it
+inline void c_matrix_unshare(struct matrix* mtr)
+{
+    mtr->data = unshare_d_array(mtr->m * mtr->n, mtr->data, &mtr->shared);
+    mtr->structure = 0;
 }
 
 #define MAKE_MATRIX_AND_RB_VALUE(matrix_name, rb_value_name, m, n)\
@@ -1,6 +1,12 @@
 #include "Matrix/matrix.h"
 #include "Helper/c_array_operations.h"
 #include "Helper/errors.h"
+#include "Helper/memory_view.h"
+#include "Helper/serialization.h"
+#include "Helper/mapped_file.h"
+#include "Helper/standard.h"
+#include "StructuredMatrix/structured.h"
+#include "StructuredMatrix/helper.h"
 #include "Vector/vector.h"
 #include "Matrix/errors.h"
 #include "Matrix/helper.h"
@@ -10,6 +16,10 @@
 
 VALUE cMatrix;
 
+//  version 2 pads the header, so the elements of mapped files are aligned
+#define MATRIX_BINARY_SIGNATURE "FMM\x02"
+
+void matrix_mark(void* data);
 void matrix_free(void* data);
 size_t matrix_size(const void* data);
 
@@ -18,7 +28,7 @@ const rb_data_type_t matrix_type =
     .wrap_struct_name = "matrix",
     .function =
     {
-        .dmark = NULL,
+        .dmark = matrix_mark,
         .dfree = matrix_free,
         .dsize = matrix_size,
     },
@@ -26,9 +36,15 @@ const rb_data_type_t matrix_type =
     .flags = RUBY_TYPED_FREE_IMMEDIATELY,
 };
 
+void matrix_mark(void* data)
+{
+    mark_shared_d_array(((struct matrix*)data)->shared);
+}
+
 void matrix_free(void* data)
 {
-    free(((*(struct matrix*)data)).data);
+    struct matrix* mtx = (struct matrix*)data;
+    release_d_array(mtx->data, mtx->shared);
     free(data);
 }
 
@@ -41,7 +57,10 @@ VALUE matrix_alloc(VALUE self)
 {
 	struct matrix* mtx = malloc(sizeof(struct matrix));
     mtx->data = NULL;
+    mtx->shared = NULL;
+    mtx->views = 0;
     mtx->frozen = false;
+    mtx->structure = 0;
 	return TypedData_Wrap_Struct(self, &matrix_type, mtx);
 }
 
@@ -63,6 +82,7 @@ VALUE matrix_set(VALUE self, VALUE row, VALUE column, VALUE v)
 {
 	struct matrix* data = get_matrix_from_rb_value(self);
     raise_check_frozen_matrix(data);
+    c_matrix_unshare(data);
 
     int m = raise_rb_value_to_int(column);
     int n = raise_rb_value_to_int(row);
@@ -94,6 +114,65 @@ VALUE matrix_get(VALUE self, VALUE row, VALUE column)
     return DBL2NUM(data->data[m + data->m * n]);
 }
 
+//  flags of enum matrix_structure, the analysis is cached until the next
+//  modification unless the elements can be changed outside of the matrix
+int matrix_structure(struct matrix* A)
+{
+    if(A->m != A->n)
+        return MATRIX_ANALYZED;
+    if(A->structure != 0)
+        return A->structure;
+
+    int structure = c_matrix_analyze(A->n, A->data);
+    if(A->views == 0 && (A->shared == NULL || A->shared->release == NULL))
+        A->structure = structure;
+    return structure;
+}
+
+//  C = A * B for the square matrix A with B of m columns
+//  returns false if A is not structured
+bool matrix_structured_left_multiply(struct matrix* A, int m, const double* B, double* C)
+{
+    int structure = matrix_structure(A);
+    int n = A->n;
+    if(structure & MATRIX_DIAGONAL)
+        c_matrix_diagonal_multiply(n, m, A->data, B, C);
+    else if(structure & MATRIX_PERMUTATION)
+    {
+        int* P = malloc(n * sizeof(int));
+        c_matrix_permutation_indices(n, A->data, P);
+        c_matrix_permute_rows(n, m, P, B, C, false);
+        free(P);
+    }
+    else if(structure & (MATRIX_LOWER | MATRIX_UPPER))
+        c_matrix_triangular_multiply(n, m, A->data, B, C, structure & MATRIX_LOWER);
+    else
+        return false;
+    return true;
+}
+
+//  C = B * A for the square matrix A with B of k rows
+//  returns false if A is not structured
+bool matrix_structured_right_multiply(int k, const double* B, struct matrix* A, double* C)
+{
+    int structure = matrix_structure(A);
+    int n = A->n;
+    if(structure & MATRIX_DIAGONAL)
+        c_matrix_multiply_diagonal(k, n, B, A->data, C);
+    else if(structure & MATRIX_PERMUTATION)
+    {
+        int* P = malloc(n * sizeof(int));
+        c_matrix_permutation_indices(n, A->data, P);
+        c_matrix_permute_columns(k, n, P, B, C);
+        free(P);
+    }
+    else if(structure & (MATRIX_LOWER | MATRIX_UPPER))
+        c_matrix_multiply_triangular(k, n, B, A->data, C, structure & MATRIX_LOWER);
+    else
+        return false;
+    return true;
+}
+
 VALUE matrix_multiply_mv(VALUE self, VALUE other)
 {
 	struct matrix* M = get_matrix_from_rb_value(self);
@@ -103,7 +182,8 @@ VALUE matrix_multiply_mv(VALUE self, VALUE other)
         rb_raise(fm_eIndexError, "Matrix columns differs from vector size");
 
     MAKE_VECTOR_AND_RB_VALUE(R, result, M->n);
-    c_matrix_vector_multiply(M->n, M->m, M->data, V->data, R->data);
+    if(!matrix_structured_left_multiply(M, 1, V->data, R->data))
+        c_matrix_vector_multiply(M->n, M->m, M->data, V->data, R->data);
     return result;
 }
 
@@ -120,8 +200,11 @@ VALUE matrix_strassen(VALUE self, VALUE other)
     int n = A->n;
 
     MAKE_MATRIX_AND_RB_VALUE(C, result, m, n);
-    fill_d_array(m * n, C->data, 0);
+    if(matrix_structured_left_multiply(A, m, B->data, C->data)
+        || matrix_structured_right_multiply(n, A->data, B, C->data))
+        return result;
 
+    fill_d_array(m * n, C->data, 0);
     c_matrix_strassen(n, k, m, A->data, B->data, C->data);
     return result;
 }
@@ -150,8 +233,7 @@ VALUE matrix_multiply_mn(VALUE self, VALUE value)
 	struct matrix* A = get_matrix_from_rb_value(self);
 
     MAKE_MATRIX_AND_RB_VALUE(R, result, A->m, A->n);
-    copy_d_array(A->m * A->n, A->data, R->data);
-    multiply_d_array(R->m * R->n, R->data, d);
+    multiply_d_array_to_result(A->m * A->n, A->data, d, R->data);
 
     return result;
 }
@@ -165,6 +247,8 @@ VALUE matrix_multiply(VALUE self, VALUE v)
         return matrix_strassen(self, v);
     if(RBASIC_CLASS(v) == cVector)
         return matrix_multiply_mv(self, v);
+    if(RTEST(rb_obj_is_kind_of(v, cStructuredMatrix)))
+        return structured_dense_left_multiply(self, v);
     rb_raise(fm_eTypeError, "Invalid klass for multiply");
 }
 
@@ -174,8 +258,7 @@ VALUE matrix_division_mn(VALUE self, VALUE value)
 	struct matrix* A = get_matrix_from_rb_value(self);
 
     MAKE_MATRIX_AND_RB_VALUE(R, result, A->m, A->n);
-    copy_d_array(A->m * A->n, A->data, R->data);
-    multiply_d_array(R->m * R->n, R->data, 1 / d);
+    multiply_d_array_to_result(A->m * A->n, A->data, 1 / d, R->data);
 
     return result;
 }
@@ -210,11 +293,27 @@ VALUE matrix_division(VALUE self, VALUE v)
     rb_raise(fm_eTypeError, "Invalid klass for division");
 }
 
+//  the clone shares data with the original until one of them is modified
 VALUE matrix_copy(VALUE self)
 {
 	struct matrix* M = get_matrix_from_rb_value(self);
-    MAKE_MATRIX_AND_RB_VALUE(R, result, M->m, M->n);
-    copy_d_array(M->m * M->n, M->data, R->data);
+
+    //  exported data can be changed through the memory view,
+    //  writes of a writable external owner must keep reaching its memory
+    if(M->views > 0 || (!M->frozen && d_array_external(M->shared)))
+    {
+        MAKE_MATRIX_AND_RB_VALUE(C, copy, M->m, M->n);
+        copy_d_array(M->m * M->n, M->data, C->data);
+        return copy;
+    }
+
+    struct matrix* R;
+    VALUE result = TypedData_Make_Struct(cMatrix, struct matrix, &matrix_type, R);
+    R->m = M->m;
+    R->n = M->n;
+    R->data = share_d_array(M->data, &M->shared);
+    R->shared = M->shared;
+    R->structure = M->structure;
     return result;
 }
 
@@ -260,11 +359,51 @@ VALUE matrix_add_from(VALUE self, VALUE other)
 	struct matrix* B = get_matrix_from_rb_value(other);
 
     raise_check_equal_size_matrix(A, B);
+    c_matrix_unshare(A);
 
     add_d_arrays_to_first(A->n * B->m, A->data, B->data);
     return self;
 }
 
+//  rank1_update!(alpha, u, v), self += alpha * u * v^T
+VALUE matrix_rank1_update(VALUE self, VALUE alpha, VALUE u, VALUE v)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    raise_check_frozen_matrix(A);
+    double d = raise_rb_value_to_double(alpha);
+    raise_check_rbasic(u, cVector, "vector");
+    raise_check_rbasic(v, cVector, "vector");
+	struct vector* U = get_vector_from_rb_value(u);
+	struct vector* V = get_vector_from_rb_value(v);
+
+    if(U->n != A->n || V->n != A->m)
+        rb_raise(fm_eIndexError, "Sizes of vectors differ from matrix size");
+    c_matrix_unshare(A);
+
+    c_matrix_rank1_update(A->m, A->n, A->data, d, U->data, V->data);
+    return self;
+}
+
+//  sherman_morrison!(u, v) turns self = A^-1 into (A + u * v^T)^-1
+VALUE matrix_sherman_morrison(VALUE self, VALUE u, VALUE v)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    raise_check_frozen_matrix(A);
+    raise_check_square_matrix(A);
+    raise_check_rbasic(u, cVector, "vector");
+    raise_check_rbasic(v, cVector, "vector");
+	struct vector* U = get_vector_from_rb_value(u);
+	struct vector* V = get_vector_from_rb_value(v);
+
+    if(U->n != A->n || V->n != A->n)
+        rb_raise(fm_eIndexError, "Sizes of vectors differ from matrix size");
+    c_matrix_unshare(A);
+
+    if(!c_matrix_sherman_morrison(A->n, A->data, U->data, V->data))
+        rb_raise(fm_eIndexError, "Matrix is singular");
+    return self;
+}
+
 VALUE matrix_sub_with(VALUE self, VALUE other)
 {
     raise_check_rbasic(other, cMatrix, "matrix");
@@ -286,6 +425,7 @@ VALUE matrix_sub_from(VALUE self, VALUE other)
 	struct matrix* B = get_matrix_from_rb_value(other);
 
     raise_check_equal_size_matrix(A, B);
+    c_matrix_unshare(A);
 
     sub_d_arrays_to_first(A->n * B->m, A->data, B->data);
     return self;
@@ -295,6 +435,18 @@ VALUE matrix_determinant(VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_square_matrix(A);
+
+    int structure = matrix_structure(A);
+    if(structure & (MATRIX_LOWER | MATRIX_UPPER))
+        return DBL2NUM(c_matrix_diagonal_product(A->n, A->data));
+    if(structure & MATRIX_PERMUTATION)
+    {
+        int* P = malloc(A->n * sizeof(int));
+        c_matrix_permutation_indices(A->n, A->data, P);
+        double sign = c_matrix_permutation_sign(A->n, P);
+        free(P);
+        return DBL2NUM(sign);
+    }
     return DBL2NUM(c_matrix_determinant(A->n, A->data));
 }
 
@@ -303,6 +455,7 @@ VALUE matrix_fill(VALUE self, VALUE value)
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_frozen_matrix(A);
     double d = raise_rb_value_to_double(value);
+    c_matrix_unshare(A);
     fill_d_array(A->m * A->n, A->data, d);
     return self;
 }
@@ -415,6 +568,219 @@ VALUE matrix_vstack(int argc, VALUE *argv, VALUE obj)
     return result;
 }
 
+//  Matrix.multi_dot(*operands), the product in the order with the fewest flops,
+//  the first operand may be a Vector as a row and the last one as a column
+VALUE matrix_multi_dot(int argc, VALUE *argv, VALUE obj)
+{
+    raise_check_no_arguments(argc);
+    bool row = !RB_SPECIAL_CONST_P(argv[0]) && RBASIC_CLASS(argv[0]) == cVector;
+    bool column = !RB_SPECIAL_CONST_P(argv[argc - 1]) && RBASIC_CLASS(argv[argc - 1]) == cVector;
+
+    //  operand i has shape[2 * i] rows and shape[2 * i + 1] columns,
+    //  the result has the columns of the last operand
+    int* shape = malloc(2 * argc * sizeof(int));
+    const double** operands = malloc(argc * sizeof(double*));
+    int columns = 0;
+    for(int i = 0; i < argc; ++i)
+    {
+        if((i == 0 && row) || (i == argc - 1 && column))
+        {
+            struct vector* V = get_vector_from_rb_value(argv[i]);
+            shape[2 * i] = (i == 0 && row) ? 1 : V->n;
+            shape[2 * i + 1] = columns = (i == 0 && row) ? V->n : 1;
+            operands[i] = V->data;
+            continue;
+        }
+        if(RB_SPECIAL_CONST_P(argv[i]) || RBASIC_CLASS(argv[i]) != cMatrix)
+        {
+            free(shape);
+            free(operands);
+            rb_raise(fm_eTypeError, "Expected class matrix");
+        }
+        struct matrix* M = get_matrix_from_rb_value(argv[i]);
+        shape[2 * i] = M->n;
+        shape[2 * i + 1] = columns = M->m;
+        operands[i] = M->data;
+    }
+
+    int* dims = malloc((argc + 1) * sizeof(int));
+    for(int i = 0; i < argc; ++i)
+        dims[i] = shape[2 * i];
+    dims[argc] = columns;
+    for(int i = 1; i < argc; ++i)
+        if(shape[2 * i - 1] != shape[2 * i])
+        {
+            free(shape);
+            free(dims);
+            free(operands);
+            rb_raise(fm_eIndexError, "First columns differs from second rows");
+        }
+    free(shape);
+
+    if(argc == 1)
+    {
+        free(dims);
+        free(operands);
+        return rb_funcall(argv[0], rb_intern("clone"), 0);
+    }
+
+    int* split = malloc(argc * argc * sizeof(int));
+    c_matrix_chain_order(argc, dims, split);
+
+    VALUE result;
+    double* R;
+    double scalar;
+    if(row && column)
+        R = &scalar;
+    else if(row || column)
+    {
+        MAKE_VECTOR_AND_RB_VALUE(V, vector, row ? dims[argc] : dims[0]);
+        result = vector;
+        R = V->data;
+    }
+    else
+    {
+        MAKE_MATRIX_AND_RB_VALUE(C, matrix, dims[argc], dims[0]);
+        result = matrix;
+        R = C->data;
+    }
+    c_matrix_chain_multiply(argc, dims, split, operands, 0, argc - 1, R);
+
+    free(dims);
+    free(operands);
+    free(split);
+    if(row && column)
+        return DBL2NUM(scalar);
+    return result;
+}
+
+#define PAIRWISE_BLOCK_ROWS 256
+
+enum pairwise_metric raise_pairwise_metric(VALUE metric)
+{
+    if(metric == Qundef || metric == ID2SYM(rb_intern("euclidean")))
+        return PAIRWISE_EUCLIDEAN;
+    if(metric == ID2SYM(rb_intern("sqeuclidean")))
+        return PAIRWISE_SQEUCLIDEAN;
+    if(metric == ID2SYM(rb_intern("cosine")))
+        return PAIRWISE_COSINE;
+    rb_raise(fm_eTypeError, "Unknown metric");
+}
+
+//  metric between rows of A and rows of B computed by blocks of rows of A,
+//  the whole matrix is returned, or the blocks are yielded if a block is given,
+//  or only [indices, values] of top nearest rows of B are kept for every row of A
+VALUE matrix_pairwise(struct matrix* A, struct matrix* B, enum pairwise_metric metric, VALUE top, VALUE block_rows)
+{
+    if(A->m != B->m)
+        rb_raise(fm_eIndexError, "Rows of different size");
+    int rows = block_rows == Qundef ? PAIRWISE_BLOCK_ROWS : raise_rb_value_to_int(block_rows);
+    if(rows <= 0)
+        rb_raise(fm_eIndexError, "Size cannot be negative or zero");
+    int k = top == Qundef || NIL_P(top) ? 0 : raise_rb_value_to_int(top);
+    if(k < 0 || (k == 0 && top != Qundef && !NIL_P(top)))
+        rb_raise(fm_eIndexError, "Size cannot be negative or zero");
+    if(k > 0 && rb_block_given_p())
+        rb_raise(fm_eTypeError, "Block is not supported with top");
+
+    int dim = A->m;
+    int na = A->n;
+    int nb = B->n;
+    // buffers are Ruby objects, so a break from the block does not leak them
+    MAKE_MATRIX_AND_RB_VALUE(BT, transposed, nb, dim);
+    MAKE_VECTOR_AND_RB_VALUE(AN, a_norms, na);
+    MAKE_VECTOR_AND_RB_VALUE(BN, b_norms, nb);
+    c_matrix_transpose(dim, nb, B->data, BT->data);
+    c_matrix_row_squared_norms(dim, na, A->data, AN->data);
+    c_matrix_row_squared_norms(dim, nb, B->data, BN->data);
+
+    VALUE result = Qnil;
+    if(k > 0)
+    {
+        k = k < nb ? k : nb;
+        rows = rows < na ? rows : na;
+        MAKE_MATRIX_AND_RB_VALUE(G, buffer, nb, rows);
+        MAKE_MATRIX_AND_RB_VALUE(D, values, k, na);
+        VALUE indices = rb_ary_new_capa(na);
+        int* I = malloc(k * sizeof(int));
+        for(int first = 0; first < na; first += rows)
+        {
+            int count = na - first < rows ? na - first : rows;
+            c_matrix_pairwise_block(count, dim, nb, A->data + first * dim, AN->data + first,
+                BT->data, BN->data, metric, G->data);
+            for(int i = 0; i < count; ++i)
+            {
+                c_matrix_top_k(nb, G->data + i * nb, k, metric == PAIRWISE_SIMILARITY,
+                    D->data + (first + i) * k, I);
+                VALUE row = rb_ary_new_capa(k);
+                for(int j = 0; j < k; ++j)
+                    rb_ary_push(row, INT2NUM(I[j]));
+                rb_ary_push(indices, row);
+            }
+        }
+        free(I);
+        RB_GC_GUARD(buffer);
+        result = rb_assoc_new(indices, values);
+    }
+    else if(rb_block_given_p())
+    {
+        for(int first = 0; first < na; first += rows)
+        {
+            int count = na - first < rows ? na - first : rows;
+            MAKE_MATRIX_AND_RB_VALUE(G, block, nb, count);
+            c_matrix_pairwise_block(count, dim, nb, A->data + first * dim, AN->data + first,
+                BT->data, BN->data, metric, G->data);
+            rb_yield_values(2, INT2NUM(first), block);
+        }
+    }
+    else
+    {
+        MAKE_MATRIX_AND_RB_VALUE(R, matrix, nb, na);
+        c_matrix_pairwise_block(na, dim, nb, A->data, AN->data, BT->data, BN->data, metric, R->data);
+        result = matrix;
+    }
+
+    RB_GC_GUARD(transposed);
+    RB_GC_GUARD(a_norms);
+    RB_GC_GUARD(b_norms);
+    return result;
+}
+
+//  Matrix.pairwise_distances(a, b = a, metric: :euclidean, top: nil, block_rows: 256),
+//  metric is :euclidean, :sqeuclidean or :cosine
+VALUE matrix_pairwise_distances(int argc, VALUE *argv, VALUE obj)
+{
+    const char* const names[] = {"metric", "top", "block_rows"};
+    VALUE options[3];
+    raise_get_options(&argc, argv, 3, names, options);
+    if(argc < 1 || argc > 2)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    enum pairwise_metric metric = raise_pairwise_metric(options[0]);
+
+    raise_check_rbasic(argv[0], cMatrix, "matrix");
+    raise_check_rbasic(argv[argc - 1], cMatrix, "matrix");
+    struct matrix* A = get_matrix_from_rb_value(argv[0]);
+    struct matrix* B = get_matrix_from_rb_value(argv[argc - 1]);
+    return matrix_pairwise(A, B, metric, options[1], options[2]);
+}
+
+//  cosine_similarity(other = self, top: nil, block_rows: 256) between rows,
+//  top keeps the most similar rows of other
+VALUE matrix_cosine_similarity(int argc, VALUE *argv, VALUE self)
+{
+    const char* const names[] = {"top", "block_rows"};
+    VALUE options[2];
+    raise_get_options(&argc, argv, 2, names, options);
+    if(argc > 1)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+
+    VALUE other = argc == 1 ? argv[0] : self;
+    raise_check_rbasic(other, cMatrix, "matrix");
+    struct matrix* A = get_matrix_from_rb_value(self);
+    struct matrix* B = get_matrix_from_rb_value(other);
+    return matrix_pairwise(A, B, PAIRWISE_SIMILARITY, options[0], options[1]);
+}
+
 VALUE matrix_hstack(int argc, VALUE *argv, VALUE obj)
 {
     raise_check_no_arguments(argc);
@@ -448,6 +814,111 @@ VALUE matrix_scalar(VALUE obj, VALUE size, VALUE value)
     return result;
 }
 
+//  Matrix.empty raises NotSupportedError for zero sizes
+void raise_check_new_matrix_sizes(VALUE obj, int m, int n)
+{
+    if(m == 0 || n == 0)
+        rb_funcall(obj, rb_intern("empty"), 0);
+    if(m < 0 || n < 0)
+        rb_raise(fm_eIndexError, "Size cannot be negative");
+}
+
+VALUE matrix_identity(VALUE obj, VALUE size)
+{
+    int n = raise_rb_value_to_int(size);
+    raise_check_new_matrix_sizes(obj, n, n);
+
+    MAKE_MATRIX_AND_RB_VALUE(C, result, n, n);
+    c_matrix_scalar(n, C->data, 1);
+    return result;
+}
+
+VALUE matrix_new_diagonal(int argc, VALUE *argv, VALUE obj)
+{
+    raise_check_new_matrix_sizes(obj, argc, argc);
+
+    MAKE_MATRIX_AND_RB_VALUE(C, result, argc, argc);
+    fill_d_array(argc * argc, C->data, 0);
+    for(int i = 0; i < argc; ++i)
+        C->data[i * (argc + 1)] = raise_rb_value_to_double(argv[i]);
+    return result;
+}
+
+VALUE matrix_build(int argc, VALUE *argv, VALUE obj)
+{
+    if(argc != 1 && argc != 2)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+
+    int n = raise_rb_value_to_int(argv[0]);
+    int m = (argc == 2) ? raise_rb_value_to_int(argv[1]) : n;
+    raise_check_new_matrix_sizes(obj, m, n);
+    if(!rb_block_given_p())
+        rb_raise(rb_eNotImpError, "Issue#17");
+
+    MAKE_MATRIX_AND_RB_VALUE(C, result, m, n);
+    for(int i = 0; i < n; ++i)
+        for(int j = 0; j < m; ++j)
+            C->data[j + m * i] = raise_rb_value_to_double(
+                rb_yield_values(2, INT2NUM(i), INT2NUM(j)));
+    return result;
+}
+
+//  copy the elements of line into C with the step
+void raise_copy_line(VALUE line, int len, double* C, int step)
+{
+    const VALUE* elements = RARRAY_CONST_PTR(line);
+    for(int i = 0; i < len; ++i)
+        C[i * step] = raise_rb_value_to_double(elements[i]);
+}
+
+//  generalization between ::rows and ::columns
+VALUE matrix_lines(VALUE obj, VALUE lines, VALUE main_is_rows)
+{
+    lines = rb_Array(lines);
+    int count = RARRAY_LEN(lines);
+    VALUE line = (count > 0) ? rb_Array(RARRAY_AREF(lines, 0)) : rb_ary_new();
+    int len = RARRAY_LEN(line);
+
+    int m = RTEST(main_is_rows) ? len : count;
+    int n = RTEST(main_is_rows) ? count : len;
+    raise_check_new_matrix_sizes(obj, m, n);
+
+    MAKE_MATRIX_AND_RB_VALUE(C, result, m, n);
+    for(int i = 0; i < count; ++i)
+    {
+        line = rb_Array(RARRAY_AREF(lines, i));
+        if(RARRAY_LEN(line) != len)
+            rb_raise(fm_eIndexError, "Lines of different size");
+        if(RTEST(main_is_rows))
+            raise_copy_line(line, len, C->data + m * i, 1);
+        else
+            raise_copy_line(line, len, C->data + i, m);
+    }
+    return result;
+}
+
+VALUE matrix_new_column_vector(VALUE obj, VALUE column)
+{
+    column = rb_Array(column);
+    int n = RARRAY_LEN(column);
+    raise_check_new_matrix_sizes(obj, 1, n);
+
+    MAKE_MATRIX_AND_RB_VALUE(C, result, 1, n);
+    raise_copy_line(column, n, C->data, 1);
+    return result;
+}
+
+VALUE matrix_new_row_vector(VALUE obj, VALUE row)
+{
+    row = rb_Array(row);
+    int m = RARRAY_LEN(row);
+    raise_check_new_matrix_sizes(obj, m, 1);
+
+    MAKE_MATRIX_AND_RB_VALUE(C, result, m, 1);
+    raise_copy_line(row, m, C->data, 1);
+    return result;
+}
+
 VALUE matrix_antisymmetric(VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
@@ -462,7 +933,8 @@ VALUE matrix_symmetric(VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_square_matrix(A);
-    if(c_matrix_symmetric(A->n, A->data))
+
+    if(matrix_structure(A) & MATRIX_SYMMETRIC)
         return Qtrue;
     return Qfalse;
 }
@@ -518,8 +990,8 @@ VALUE matrix_diagonal(VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_square_matrix(A);
-    
-    if(c_matrix_diagonal(A->n, A->data))
+
+    if(matrix_structure(A) & MATRIX_DIAGONAL)
         return Qtrue;
     return Qfalse;
 }
@@ -617,7 +1089,7 @@ VALUE matrix_lower_triangular(VALUE self)
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_square_matrix(A);
 
-    if(c_matrix_lower_triangular(A->n, A->data))
+    if(matrix_structure(A) & MATRIX_LOWER)
         return Qtrue;
     return Qfalse;
 }
@@ -627,7 +1099,7 @@ VALUE matrix_upper_triangular(VALUE self)
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_square_matrix(A);
 
-    if(c_matrix_upper_triangular(A->n, A->data))
+    if(matrix_structure(A) & MATRIX_UPPER)
         return Qtrue;
     return Qfalse;
 }
@@ -637,42 +1109,153 @@ VALUE matrix_permutation(VALUE self)
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_square_matrix(A);
 
-    if(c_matrix_permutation(A->n, A->data))
+    if(matrix_structure(A) & MATRIX_PERMUTATION)
         return Qtrue;
     return Qfalse;
 }
 
-VALUE matrix_orthogonal(VALUE self)
+//  orthogonal?(tolerance = 0)
+VALUE matrix_orthogonal(int argc, VALUE *argv, VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_square_matrix(A);
-    
-    int n = A->n;
-    double* B = malloc(sizeof(double) * n * n);
-    double* C = malloc(sizeof(double) * n * n);
+    double tolerance = raise_rb_value_to_tolerance(argc, argv);
 
-    c_matrix_transpose(n, n, A->data, B);
-    fill_d_array(n * n, C, 0);
-    c_matrix_strassen(n, n, n, A->data, B, C);
-    bool result = c_matrix_identity(n, C);
-
-    free(B);
-    free(C);
-    if(result)
+    if(c_matrix_orthonormal_rows(A->m, A->n, A->data, tolerance))
         return Qtrue;
     return Qfalse;
 }
 
+//  inverse of the structured matrix to B
+//  returns false if A is singular
+bool matrix_structured_inverse(struct matrix* A, int structure, double* B)
+{
+    int n = A->n;
+    if(structure & MATRIX_PERMUTATION)
+    {
+        c_matrix_transpose(n, n, A->data, B);
+        return true;
+    }
+    c_matrix_scalar(n, B, 1);
+    if(structure & MATRIX_DIAGONAL)
+    {
+        for(int i = 0; i < n; ++i)
+        {
+            double d = A->data[i * (n + 1)];
+            if(d == 0)
+                return false;
+            B[i * (n + 1)] = 1 / d;
+        }
+        return true;
+    }
+    return c_matrix_triangular_solve(n, n, A->data, B, structure & MATRIX_LOWER);
+}
+
 VALUE matrix_inverse(VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
     raise_check_square_matrix(A);
     MAKE_MATRIX_AND_RB_VALUE(R, result, A->n, A->n);
-    if(!c_matrix_inverse(R->n, A->data, R->data))
+
+    int structure = matrix_structure(A);
+    bool invertible;
+    if(structure & (MATRIX_DIAGONAL | MATRIX_LOWER | MATRIX_UPPER | MATRIX_PERMUTATION))
+        invertible = matrix_structured_inverse(A, structure, R->data);
+    else
+        invertible = c_matrix_inverse(R->n, A->data, R->data);
+    if(!invertible)
         rb_raise(fm_eIndexError, "The discriminant is zero");
     return result;
 }
 
+//  solves A * X = B with B of m columns by the kernel for the structure of A,
+//  refines the solution iteratively if refine
+//  returns false if A is singular
+bool matrix_solve_to(struct matrix* A, int m, const double* B, double* X, bool refine)
+{
+    struct matrix_solver S;
+    if(!c_matrix_solver_init(&S, A->n, A->data, matrix_structure(A)))
+        return false;
+    c_matrix_solver_apply(&S, m, B, X);
+    if(refine)
+        c_matrix_solver_refine(&S, A->data, m, B, X);
+    c_matrix_solver_free(&S);
+    return true;
+}
+
+//  solve(b, refine: false) for a Vector or a Matrix b
+VALUE matrix_solve(int argc, VALUE *argv, VALUE self)
+{
+    const char* const names[] = {"refine"};
+    VALUE option;
+    raise_get_options(&argc, argv, 1, names, &option);
+    if(argc != 1)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    bool refine = option != Qundef && RTEST(option);
+    VALUE b = argv[0];
+
+	struct matrix* A = get_matrix_from_rb_value(self);
+    raise_check_square_matrix(A);
+
+    if(!RB_SPECIAL_CONST_P(b) && RBASIC_CLASS(b) == cVector)
+    {
+        struct vector* V = get_vector_from_rb_value(b);
+        if(V->n != A->n)
+            rb_raise(fm_eIndexError, "Matrix columns differs from vector size");
+        MAKE_VECTOR_AND_RB_VALUE(X, result, A->n);
+        if(!matrix_solve_to(A, 1, V->data, X->data, refine))
+            rb_raise(fm_eIndexError, "Matrix is singular");
+        return result;
+    }
+
+    raise_check_rbasic(b, cMatrix, "matrix");
+	struct matrix* B = get_matrix_from_rb_value(b);
+    if(B->n != A->n)
+        rb_raise(fm_eIndexError, "Columns of different size");
+    MAKE_MATRIX_AND_RB_VALUE(X, result, B->m, A->n);
+    if(!matrix_solve_to(A, B->m, B->data, X->data, refine))
+        rb_raise(fm_eIndexError, "Matrix is singular");
+    return result;
+}
+
+VALUE matrix_syrk_with(VALUE self, bool trans, VALUE packed)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    int size = trans ? A->m : A->n;
+    if(packed != Qundef && RTEST(packed))
+    {
+        MAKE_STRUCTURED_AND_RB_VALUE(S, result, STRUCTURE_SYMMETRIC, size, 0, 0);
+        c_matrix_syrk(A->m, A->n, A->data, S->data, trans, true);
+        return result;
+    }
+
+    MAKE_MATRIX_AND_RB_VALUE(C, result, size, size);
+    c_matrix_syrk(A->m, A->n, A->data, C->data, trans, false);
+    return result;
+}
+
+//  syrk(trans: false, packed: false), A * A^T or A^T * A with trans
+VALUE matrix_syrk(int argc, VALUE *argv, VALUE self)
+{
+    const char* const names[] = {"trans", "packed"};
+    VALUE options[2];
+    raise_get_options(&argc, argv, 2, names, options);
+    if(argc != 0)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    return matrix_syrk_with(self, options[0] != Qundef && RTEST(options[0]), options[1]);
+}
+
+//  gram(packed: false), A^T * A
+VALUE matrix_gram(int argc, VALUE *argv, VALUE self)
+{
+    const char* const names[] = {"packed"};
+    VALUE packed;
+    raise_get_options(&argc, argv, 1, names, &packed);
+    if(argc != 0)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    return matrix_syrk_with(self, true, packed);
+}
+
 VALUE matrix_adjugate(VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
@@ -688,57 +1271,51 @@ VALUE matrix_exponentiation(VALUE self, VALUE value)
 	struct matrix* A = get_matrix_from_rb_value(self);
     int d = raise_rb_value_to_int(value);
     
+    if(A->m != A->n && d != 1)
+        rb_raise(fm_eIndexError, "Invalid exponentiation");
+
     MAKE_MATRIX_AND_RB_VALUE(C, result, A->m, A->n);
     if(!c_matrix_exponentiation(A->m, A->n, A->data, C->data, d))
-        rb_raise(fm_eIndexError, "Invalid exponentiation");
+        rb_raise(fm_eIndexError, "The discriminant is zero");
     return result;
 }
 
-VALUE matrix_normal(VALUE self)
+//  matrix exponential
+VALUE matrix_expm(VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
-    if(A->m != A-> n)
+    raise_check_square_matrix(A);
+
+    MAKE_MATRIX_AND_RB_VALUE(E, result, A->n, A->n);
+    if(!c_matrix_expm(A->n, A->data, E->data))
+        rb_raise(fm_eIndexError, "Pade approximant is singular");
+    return result;
+}
+
+//  normal?(tolerance = 0)
+VALUE matrix_normal(int argc, VALUE *argv, VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    double tolerance = raise_rb_value_to_tolerance(argc, argv);
+    if(A->m != A->n)
         return Qfalse;
-    
-    int n = A->n;
-    double* B = malloc(n * n * sizeof(double));
-    double* C = malloc(n * n * sizeof(double));
-    double* D = malloc(n * n * sizeof(double));
-    
-    c_matrix_transpose(n, n, A->data, B);
-    c_matrix_strassen(n, n, n, A->data, B, C);
-    c_matrix_strassen(n, n, n, B, A->data, D);
-    
-    VALUE res = Qfalse;
-    if(equal_d_arrays(n * n, C, D))
-        res = Qtrue;
-    
-    free(B);
-    free(C);
-    free(D);
-    return res;
+
+    if(c_matrix_normal(A->n, A->data, tolerance))
+        return Qtrue;
+    return Qfalse;
 }
 
-VALUE matrix_unitary(VALUE self)
+//  unitary?(tolerance = 0)
+VALUE matrix_unitary(int argc, VALUE *argv, VALUE self)
 {
 	struct matrix* A = get_matrix_from_rb_value(self);
-    if(A->m != A-> n)
+    double tolerance = raise_rb_value_to_tolerance(argc, argv);
+    if(A->m != A->n)
         return Qfalse;
-    
-    int n = A->n;
-    double* B = malloc(n * n * sizeof(double));
-    double* C = malloc(n * n * sizeof(double));
-    
-    c_matrix_transpose(n, n, A->data, B);
-    c_matrix_strassen(n, n, n, A->data, B, C);
-    
-    VALUE res = Qfalse;
-    if(c_matrix_identity(n, C))
-        res = Qtrue;
-    
-    free(B);
-    free(C);
-    return res;
+
+    if(c_matrix_orthonormal_rows(A->m, A->n, A->data, tolerance))
+        return Qtrue;
+    return Qfalse;
 }
 
 VALUE matrix_freeze(VALUE self)
@@ -768,6 +1345,584 @@ VALUE matrix_lup(VALUE self)
     return result;
 }
 
+//  part of the matrix which is iterated by each and each_with_index
+enum matrix_part raise_rb_value_to_matrix_part(VALUE which)
+{
+    if(SYMBOL_P(which))
+    {
+        ID id = SYM2ID(which);
+        if(id == rb_intern("all"))
+            return PART_ALL;
+        if(id == rb_intern("diagonal"))
+            return PART_DIAGONAL;
+        if(id == rb_intern("off_diagonal"))
+            return PART_OFF_DIAGONAL;
+        if(id == rb_intern("lower"))
+            return PART_LOWER;
+        if(id == rb_intern("strict_lower"))
+            return PART_STRICT_LOWER;
+        if(id == rb_intern("strict_upper"))
+            return PART_STRICT_UPPER;
+        if(id == rb_intern("upper"))
+            return PART_UPPER;
+    }
+    rb_raise(rb_eArgError, "expected %"PRIsVALUE" to be one of :all, :diagonal, "
+        ":off_diagonal, :lower, :strict_lower, :strict_upper or :upper", rb_inspect(which));
+    return PART_ALL;
+}
+
+//  the block can change the matrix, so the data is read on each step
+VALUE matrix_each_part(int argc, VALUE *argv, VALUE self, bool with_index)
+{
+    if(argc > 1)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    enum matrix_part part = (argc == 1) ? raise_rb_value_to_matrix_part(argv[0]) : PART_ALL;
+	struct matrix* A = get_matrix_from_rb_value(self);
+
+    for(int i = 0; i < A->n; ++i)
+    {
+        int begin, end;
+        c_matrix_part_columns(part, A->m, i, &begin, &end);
+        for(int j = begin; j < end; ++j)
+        {
+            if(part == PART_OFF_DIAGONAL && i == j)
+                continue;
+            VALUE elem = DBL2NUM(A->data[j + A->m * i]);
+            if(with_index)
+                rb_yield_values(3, elem, INT2NUM(i), INT2NUM(j));
+            else
+                rb_yield(elem);
+        }
+    }
+    return self;
+}
+
+VALUE matrix_each(int argc, VALUE *argv, VALUE self)
+{
+    RETURN_ENUMERATOR(self, argc, argv);
+    return matrix_each_part(argc, argv, self, false);
+}
+
+VALUE matrix_each_with_index(int argc, VALUE *argv, VALUE self)
+{
+    RETURN_ENUMERATOR(self, argc, argv);
+    return matrix_each_part(argc, argv, self, true);
+}
+
+VALUE matrix_each_with_index_self(VALUE self)
+{
+    RETURN_ENUMERATOR(self, 0, NULL);
+	struct matrix* A = get_matrix_from_rb_value(self);
+    raise_check_frozen_matrix(A);
+
+    for(int i = 0; i < A->n; ++i)
+        for(int j = 0; j < A->m; ++j)
+        {
+            VALUE elem = DBL2NUM(A->data[j + A->m * i]);
+            double v = raise_rb_value_to_double(
+                rb_yield_values(3, elem, INT2NUM(i), INT2NUM(j)));
+            raise_check_frozen_matrix(A);
+            c_matrix_unshare(A);
+            A->data[j + A->m * i] = v;
+        }
+    return self;
+}
+
+VALUE matrix_row_to_a(struct matrix* A, int i)
+{
+    VALUE row = rb_ary_new_capa(A->m);
+    for(int j = 0; j < A->m; ++j)
+        rb_ary_push(row, DBL2NUM(A->data[j + A->m * i]));
+    return row;
+}
+
+VALUE matrix_to_a(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+
+    VALUE rows = rb_ary_new_capa(A->n);
+    for(int i = 0; i < A->n; ++i)
+        rb_ary_push(rows, matrix_row_to_a(A, i));
+    return rows;
+}
+
+//  yields rows as arrays and returns array of results
+VALUE matrix_collect(VALUE self)
+{
+    RETURN_ENUMERATOR(self, 0, NULL);
+	struct matrix* A = get_matrix_from_rb_value(self);
+
+    VALUE result = rb_ary_new_capa(A->n);
+    for(int i = 0; i < A->n; ++i)
+        rb_ary_push(result, rb_yield(matrix_row_to_a(A, i)));
+    return result;
+}
+
+VALUE matrix_sum(int argc, VALUE *argv, VALUE self)
+{
+    enum summation method = raise_rb_value_to_summation(argc, argv);
+	struct matrix* A = get_matrix_from_rb_value(self);
+    return DBL2NUM(sum_d_array(A->m * A->n, A->data, method));
+}
+
+VALUE matrix_mean(int argc, VALUE *argv, VALUE self)
+{
+    enum summation method = raise_rb_value_to_summation(argc, argv);
+	struct matrix* A = get_matrix_from_rb_value(self);
+    return DBL2NUM(sum_d_array(A->m * A->n, A->data, method) / (A->m * A->n));
+}
+
+VALUE matrix_min(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    return DBL2NUM(A->data[argmin_d_array(A->m * A->n, A->data)]);
+}
+
+VALUE matrix_max(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    return DBL2NUM(A->data[argmax_d_array(A->m * A->n, A->data)]);
+}
+
+//  [row, column] of the element with index idx
+VALUE matrix_index_to_rb_value(struct matrix* A, int idx)
+{
+    return rb_assoc_new(INT2NUM(idx / A->m), INT2NUM(idx % A->m));
+}
+
+VALUE matrix_argmin(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    return matrix_index_to_rb_value(A, argmin_d_array(A->m * A->n, A->data));
+}
+
+VALUE matrix_argmax(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    return matrix_index_to_rb_value(A, argmax_d_array(A->m * A->n, A->data));
+}
+
+//  :fro (by default), 1 or :inf
+VALUE matrix_norm(int argc, VALUE *argv, VALUE self)
+{
+    if(argc > 1)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    struct matrix* A = get_matrix_from_rb_value(self);
+
+    if(argc == 0 || argv[0] == ID2SYM(rb_intern("fro")))
+        return DBL2NUM(sqrt(squares_sum_d_array(A->m * A->n, A->data)));
+    if(argv[0] == INT2FIX(1))
+        return DBL2NUM(c_matrix_norm_1(A->m, A->n, A->data));
+    if(argv[0] == ID2SYM(rb_intern("inf")))
+        return DBL2NUM(c_matrix_norm_inf(A->m, A->n, A->data));
+    rb_raise(fm_eTypeError, "Unknown norm");
+    return Qnil;
+}
+
+VALUE matrix_row_sums(int argc, VALUE *argv, VALUE self)
+{
+    enum summation method = raise_rb_value_to_summation(argc, argv);
+	struct matrix* A = get_matrix_from_rb_value(self);
+    MAKE_VECTOR_AND_RB_VALUE(R, result, A->n);
+    c_matrix_row_sums(A->m, A->n, A->data, R->data, method);
+    return result;
+}
+
+VALUE matrix_column_sums(int argc, VALUE *argv, VALUE self)
+{
+    enum summation method = raise_rb_value_to_summation(argc, argv);
+	struct matrix* A = get_matrix_from_rb_value(self);
+    MAKE_VECTOR_AND_RB_VALUE(R, result, A->m);
+    c_matrix_column_sums(A->m, A->n, A->data, R->data, method);
+    return result;
+}
+
+VALUE matrix_row_means(int argc, VALUE *argv, VALUE self)
+{
+    VALUE result = matrix_row_sums(argc, argv, self);
+    struct vector* R = get_vector_from_rb_value(result);
+    multiply_d_array(R->n, R->data, 1.0 / get_matrix_from_rb_value(self)->m);
+    return result;
+}
+
+VALUE matrix_column_means(int argc, VALUE *argv, VALUE self)
+{
+    VALUE result = matrix_column_sums(argc, argv, self);
+    struct vector* R = get_vector_from_rb_value(result);
+    multiply_d_array(R->n, R->data, 1.0 / get_matrix_from_rb_value(self)->n);
+    return result;
+}
+
+VALUE matrix_row_extremum(VALUE self, bool max)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    MAKE_VECTOR_AND_RB_VALUE(R, result, A->n);
+    c_matrix_row_extremum(A->m, A->n, A->data, R->data, max);
+    return result;
+}
+
+VALUE matrix_column_extremum(VALUE self, bool max)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    MAKE_VECTOR_AND_RB_VALUE(R, result, A->m);
+    c_matrix_column_extremum(A->m, A->n, A->data, R->data, max);
+    return result;
+}
+
+VALUE matrix_row_max(VALUE self)
+{
+    return matrix_row_extremum(self, true);
+}
+
+VALUE matrix_row_min(VALUE self)
+{
+    return matrix_row_extremum(self, false);
+}
+
+VALUE matrix_column_max(VALUE self)
+{
+    return matrix_column_extremum(self, true);
+}
+
+VALUE matrix_column_min(VALUE self)
+{
+    return matrix_column_extremum(self, false);
+}
+
+//  element-wise function into a new matrix, self for bang methods or the out: matrix
+VALUE matrix_math(int argc, VALUE *argv, VALUE self, enum math_function f, bool bang)
+{
+    VALUE out = raise_get_out_option(&argc, argv);
+    double params[2];
+    raise_math_arguments(argc, argv, f, params);
+	struct matrix* A = get_matrix_from_rb_value(self);
+
+    if(bang)
+    {
+        if(!NIL_P(out))
+            rb_raise(fm_eTypeError, "Unknown option");
+        out = self;
+    }
+    if(NIL_P(out))
+    {
+        MAKE_MATRIX_AND_RB_VALUE(R, result, A->m, A->n);
+        math_d_array(A->m * A->n, A->data, R->data, f, params);
+        return result;
+    }
+
+    raise_check_rbasic(out, cMatrix, "matrix");
+	struct matrix* R = get_matrix_from_rb_value(out);
+    raise_check_equal_size_matrix(A, R);
+    raise_check_frozen_matrix(R);
+    c_matrix_unshare(R);
+    math_d_array(A->m * A->n, A->data, R->data, f, params);
+    return out;
+}
+
+#define MATRIX_MATH_METHODS(name, f)                        \
+VALUE matrix_##name(int argc, VALUE *argv, VALUE self)      \
+{                                                           \
+    return matrix_math(argc, argv, self, f, false);         \
+}                                                           \
+VALUE matrix_##name##_self(int argc, VALUE *argv, VALUE self)\
+{                                                           \
+    return matrix_math(argc, argv, self, f, true);          \
+}
+
+MATRIX_MATH_METHODS(exp, MATH_EXP)
+MATRIX_MATH_METHODS(log, MATH_LOG)
+MATRIX_MATH_METHODS(sqrt, MATH_SQRT)
+MATRIX_MATH_METHODS(sin, MATH_SIN)
+MATRIX_MATH_METHODS(cos, MATH_COS)
+MATRIX_MATH_METHODS(tanh, MATH_TANH)
+MATRIX_MATH_METHODS(sigmoid, MATH_SIGMOID)
+MATRIX_MATH_METHODS(pow, MATH_POW)
+MATRIX_MATH_METHODS(clamp, MATH_CLAMP)
+
+//  Matrix.convert, the rows of a standard matrix are read directly
+VALUE matrix_convert(VALUE obj, VALUE other)
+{
+    if(!RB_SPECIAL_CONST_P(other) && RBASIC_CLASS(other) == cMatrix)
+        return matrix_copy(other);
+
+    VALUE rows = get_standard_array(other, "Matrix", "@rows");
+    if(NIL_P(rows))
+        rows = rb_funcall(other, rb_intern("to_a"), 0);
+    return matrix_lines(obj, rows, Qtrue);
+}
+
+//  Matrix#convert
+VALUE matrix_to_standard(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    VALUE rows = matrix_to_a(self);
+    return rb_funcall(get_standard_class("Matrix"), rb_intern("new"), 2, rows, INT2NUM(A->m));
+}
+
+//  compare with any object with row_size, column_size and []
+VALUE matrix_equal_by_index(struct matrix* A, VALUE other)
+{
+    if(!rb_respond_to(other, rb_intern("row_size")) || !rb_respond_to(other, rb_intern("column_size"))
+        || !rb_respond_to(other, rb_intern("[]")))
+        return Qfalse;
+    if(!rb_equal(rb_funcall(other, rb_intern("row_size"), 0), INT2NUM(A->n))
+        || !rb_equal(rb_funcall(other, rb_intern("column_size"), 0), INT2NUM(A->m)))
+        return Qfalse;
+
+    for(int i = 0; i < A->n; ++i)
+        for(int j = 0; j < A->m; ++j)
+        {
+            VALUE elem = rb_funcall(other, rb_intern("[]"), 2, INT2NUM(i), INT2NUM(j));
+            if(A->data[j + A->m * i] != rb_value_to_f(elem))
+                return Qfalse;
+        }
+    return Qtrue;
+}
+
+//  ==, the rows of a standard matrix are compared without calls of []
+VALUE matrix_equal_to(VALUE self, VALUE other)
+{
+    if(!RB_SPECIAL_CONST_P(other) && RBASIC_CLASS(other) == cMatrix)
+        return matrix_equal(self, other);
+
+    struct matrix* A = get_matrix_from_rb_value(self);
+    VALUE rows = get_standard_array(other, "Matrix", "@rows");
+    if(NIL_P(rows))
+        return matrix_equal_by_index(A, other);
+
+    if(RARRAY_LEN(rows) != A->n)
+        return Qfalse;
+    for(int i = 0; i < A->n; ++i)
+    {
+        VALUE row = RARRAY_AREF(rows, i);
+        if(!RB_TYPE_P(row, T_ARRAY) || RARRAY_LEN(row) != A->m)
+            return Qfalse;
+        for(int j = 0; j < A->m; ++j)
+            if(A->data[j + A->m * i] != rb_value_to_f(RARRAY_AREF(row, j)))
+                return Qfalse;
+    }
+    return Qtrue;
+}
+
+//  rows count, columns count and little-endian elements after a signature
+VALUE matrix_to_binary(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    int shape[2] = {A->n, A->m};
+    return d_array_to_binary(MATRIX_BINARY_SIGNATURE, 2, shape, A->data);
+}
+
+VALUE matrix_from_binary(VALUE obj, VALUE str)
+{
+    int shape[2];
+    raise_check_binary(str, MATRIX_BINARY_SIGNATURE, 2, shape);
+
+    MAKE_MATRIX_AND_RB_VALUE(R, result, shape[1], shape[0]);
+    d_array_from_binary(str, 2, R->data);
+    return result;
+}
+
+//  Marshal support
+VALUE matrix_dump(VALUE self, VALUE level)
+{
+    return matrix_to_binary(self);
+}
+
+VALUE matrix_save_npy(VALUE self, VALUE path)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    int shape[2] = {A->n, A->m};
+    raise_save_npy(path, 2, shape, A->data);
+    return self;
+}
+
+//  one-dimensional array is loaded as a row
+VALUE matrix_load_npy(VALUE obj, VALUE path)
+{
+    int ndim;
+    int shape[2];
+    bool fortran_order;
+    FILE* file = raise_open_npy(path, &ndim, shape, &fortran_order);
+
+    int rows = (ndim == 1) ? 1 : shape[0];
+    int columns = (ndim == 1) ? shape[0] : shape[1];
+    MAKE_MATRIX_AND_RB_VALUE(R, result, columns, rows);
+
+    if(!fortran_order || ndim == 1)
+    {
+        raise_read_npy(file, path, rows * columns, R->data);
+        return result;
+    }
+
+    //  the buffer is a Ruby object, so it is not leaked if reading fails
+    MAKE_MATRIX_AND_RB_VALUE(T, buffer, rows, columns);
+    raise_read_npy(file, path, rows * columns, T->data);
+    c_matrix_transpose(rows, columns, T->data, R->data);
+    RB_GC_GUARD(buffer);
+    return result;
+}
+
+#ifdef FAST_MATRIX_MAPPED_FILE
+//  matrix backed by the file with the binary form of the matrix,
+//  frozen in the read mode
+VALUE matrix_mmap_file(VALUE obj, VALUE path, VALUE rows, VALUE columns, VALUE mode)
+{
+    enum map_mode map_mode = raise_rb_value_to_map_mode(mode);
+    int shape[2];
+    shape[0] = NIL_P(rows) ? 0 : raise_rb_value_to_int(rows);
+    shape[1] = NIL_P(columns) ? 0 : raise_rb_value_to_int(columns);
+    if(shape[0] < 0 || shape[1] < 0)
+        rb_raise(fm_eIndexError, "Size cannot be negative");
+
+    struct matrix* C;
+    VALUE result = TypedData_Make_Struct(cMatrix, struct matrix, &matrix_type, C);
+    C->data = raise_map_d_array(path, MATRIX_BINARY_SIGNATURE, 2, shape, map_mode, &C->shared);
+    C->m = shape[1];
+    C->n = shape[0];
+    C->frozen = map_mode == MAP_MODE_READ;
+    return result;
+}
+#endif /* FAST_MATRIX_MAPPED_FILE */
+
+#ifdef FAST_MATRIX_SHARED_MEMORY
+//  freeze the matrix and move its elements to memory shared with forked processes
+VALUE matrix_freeze_shared(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    if(A->views > 0)
+        rb_raise(fm_eTypeError, "Can't move matrix with exported memory views");
+
+    A->frozen = true;
+    A->data = move_d_array_to_shared_memory(A->m * A->n, A->data, &A->shared);
+    return self;
+}
+
+VALUE matrix_shared_memory(VALUE self)
+{
+	struct matrix* A = get_matrix_from_rb_value(self);
+    if(d_array_in_shared_memory(A->shared))
+        return Qtrue;
+    return Qfalse;
+}
+#endif /* FAST_MATRIX_SHARED_MEMORY */
+
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+bool matrix_memory_view_get(VALUE self, rb_memory_view_t* view, int flags)
+{
+	struct matrix* M = get_matrix_from_rb_value(self);
+    if((flags & RUBY_MEMORY_VIEW_WRITABLE) && M->frozen)
+        return false;
+    if(!M->frozen)
+        c_matrix_unshare(M);
+
+    M->structure = 0;
+    ++M->views;
+    int shape[2] = {M->n, M->m};
+    return export_d_array_memory_view(view, self, M->data, 2, shape, M->frozen);
+}
+
+bool matrix_memory_view_release(VALUE self, rb_memory_view_t* view)
+{
+	struct matrix* M = get_matrix_from_rb_value(self);
+    --M->views;
+    return release_d_array_memory_view(view);
+}
+
+bool matrix_memory_view_available(VALUE self)
+{
+    return true;
+}
+
+const rb_memory_view_entry_t matrix_memory_view_entry =
+{
+    .get_func = matrix_memory_view_get,
+    .release_func = matrix_memory_view_release,
+    .available_p_func = matrix_memory_view_available,
+};
+
+//  optional rows and columns count after the source, 0 if not given
+void raise_memory_view_arguments(int argc, VALUE* argv, int* rows, int* columns)
+{
+    if(argc < 1 || argc > 3)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    *rows = (argc > 1) ? raise_rb_value_to_int(argv[1]) : 0;
+    *columns = (argc > 2) ? raise_rb_value_to_int(argv[2]) : 0;
+}
+
+//  size of the matrix from count elements with ndim dimensions
+bool memory_view_matrix_size(int count, int ndim, const ssize_t* shape, int rows, int columns, int* m, int* n)
+{
+    *n = rows;
+    *m = columns;
+    if(rows == 0 && ndim == 2 && shape != NULL)
+    {
+        *n = shape[0];
+        *m = shape[1];
+    }
+    else if(columns == 0 && rows > 0)
+        *m = count / rows;
+    return *m > 0 && *n > 0 && *m * *n == count;
+}
+
+//  copy elements from the memory view or from the packed String
+VALUE matrix_from_memory_view(int argc, VALUE* argv, VALUE obj)
+{
+    int rows, columns, m, n, count;
+    raise_memory_view_arguments(argc, argv, &rows, &columns);
+    VALUE source = argv[0];
+
+    if(RB_TYPE_P(source, T_STRING))
+    {
+        long len = RSTRING_LEN(source);
+        count = len / sizeof(double);
+        if(len % sizeof(double) != 0 || !memory_view_matrix_size(count, 1, NULL, rows, columns, &m, &n))
+            rb_raise(fm_eIndexError, "Size of matrix differs from String size");
+
+        MAKE_MATRIX_AND_RB_VALUE(C, result, m, n);
+        memcpy(C->data, RSTRING_PTR(source), len);
+        return result;
+    }
+
+    rb_memory_view_t view;
+    raise_get_d_array_memory_view(source, &view, false, &count);
+    if(!memory_view_matrix_size(count, view.ndim, view.shape, rows, columns, &m, &n))
+    {
+        rb_memory_view_release(&view);
+        rb_raise(fm_eIndexError, "Size of matrix differs from memory view size");
+    }
+
+    MAKE_MATRIX_AND_RB_VALUE(C, result, m, n);
+    copy_d_array_from_memory_view(count, &view, C->data);
+    rb_memory_view_release(&view);
+    return result;
+}
+
+//  matrix which uses elements of the memory view without copying,
+//  the matrix is frozen if the view is readonly
+VALUE matrix_wrap_memory_view(int argc, VALUE* argv, VALUE obj)
+{
+    int rows, columns, m, n, count;
+    raise_memory_view_arguments(argc, argv, &rows, &columns);
+
+    rb_memory_view_t view;
+    raise_get_d_array_memory_view(argv[0], &view, true, &count);
+    if(!memory_view_matrix_size(count, view.ndim, view.shape, rows, columns, &m, &n))
+    {
+        rb_memory_view_release(&view);
+        rb_raise(fm_eIndexError, "Size of matrix differs from memory view size");
+    }
+
+    struct matrix* C;
+    VALUE result = TypedData_Make_Struct(cMatrix, struct matrix, &matrix_type, C);
+    C->m = m;
+    C->n = n;
+    C->data = view.data;
+    C->frozen = view.readonly;
+    C->shared = wrap_d_array_memory_view(&view);
+    return result;
+}
+#endif /* HAVE_RUBY_MEMORY_VIEW_H */
+
 void init_fm_matrix()
 {
     VALUE  mod = rb_define_module("FastMatrix");
@@ -787,6 +1942,8 @@ void init_fm_matrix()
 	rb_define_method(cMatrix, "add!", matrix_add_from, 1);
 	rb_define_method(cMatrix, "-", matrix_sub_with, 1);
 	rb_define_method(cMatrix, "sub!", matrix_sub_from, 1);
+	rb_define_method(cMatrix, "rank1_update!", matrix_rank1_update, 3);
+	rb_define_method(cMatrix, "sherman_morrison!", matrix_sherman_morrison, 2);
 	rb_define_method(cMatrix, "fill!", matrix_fill, 1);
     rb_define_method(cMatrix, "abs", matrix_abs, 0);
     rb_define_method(cMatrix, ">=", matrix_greater_or_equal, 1);
@@ -812,16 +1969,89 @@ void init_fm_matrix()
     rb_define_method(cMatrix, "lower_triangular?", matrix_lower_triangular, 0);
     rb_define_method(cMatrix, "upper_triangular?", matrix_upper_triangular, 0);
     rb_define_method(cMatrix, "permutation?", matrix_permutation, 0);
-    rb_define_method(cMatrix, "orthogonal?", matrix_orthogonal, 0);
+    rb_define_method(cMatrix, "orthogonal?", matrix_orthogonal, -1);
     rb_define_method(cMatrix, "inverse", matrix_inverse, 0);
+    rb_define_method(cMatrix, "solve", matrix_solve, -1);
+    rb_define_method(cMatrix, "cosine_similarity", matrix_cosine_similarity, -1);
+    rb_define_method(cMatrix, "syrk", matrix_syrk, -1);
+    rb_define_method(cMatrix, "gram", matrix_gram, -1);
     rb_define_method(cMatrix, "adjugate", matrix_adjugate, 0);
     rb_define_method(cMatrix, "/", matrix_division, 1);
     rb_define_method(cMatrix, "**", matrix_exponentiation, 1);
-    rb_define_method(cMatrix, "normal?", matrix_normal, 0);
-    rb_define_method(cMatrix, "unitary?", matrix_unitary, 0);
+    rb_define_method(cMatrix, "expm", matrix_expm, 0);
+    rb_define_method(cMatrix, "normal?", matrix_normal, -1);
+    rb_define_method(cMatrix, "unitary?", matrix_unitary, -1);
     rb_define_method(cMatrix, "freeze", matrix_freeze, 0);
     rb_define_method(cMatrix, "lup", matrix_lup, 0);
+    rb_define_method(cMatrix, "each", matrix_each, -1);
+    rb_define_method(cMatrix, "each_with_index", matrix_each_with_index, -1);
+    rb_define_method(cMatrix, "each_with_index!", matrix_each_with_index_self, 0);
+    rb_define_method(cMatrix, "collect", matrix_collect, 0);
+    rb_define_method(cMatrix, "to_a", matrix_to_a, 0);
+    rb_define_private_method(cMatrix, "rows", matrix_to_a, 0);
+    rb_define_method(cMatrix, "sum", matrix_sum, -1);
+    rb_define_method(cMatrix, "mean", matrix_mean, -1);
+    rb_define_method(cMatrix, "min", matrix_min, 0);
+    rb_define_method(cMatrix, "max", matrix_max, 0);
+    rb_define_method(cMatrix, "argmin", matrix_argmin, 0);
+    rb_define_method(cMatrix, "argmax", matrix_argmax, 0);
+    rb_define_method(cMatrix, "norm", matrix_norm, -1);
+    rb_define_method(cMatrix, "row_sums", matrix_row_sums, -1);
+    rb_define_method(cMatrix, "column_sums", matrix_column_sums, -1);
+    rb_define_method(cMatrix, "row_means", matrix_row_means, -1);
+    rb_define_method(cMatrix, "column_means", matrix_column_means, -1);
+    rb_define_method(cMatrix, "row_max", matrix_row_max, 0);
+    rb_define_method(cMatrix, "row_min", matrix_row_min, 0);
+    rb_define_method(cMatrix, "column_max", matrix_column_max, 0);
+    rb_define_method(cMatrix, "column_min", matrix_column_min, 0);
+    rb_define_method(cMatrix, "exp", matrix_exp, -1);
+    rb_define_method(cMatrix, "exp!", matrix_exp_self, -1);
+    rb_define_method(cMatrix, "log", matrix_log, -1);
+    rb_define_method(cMatrix, "log!", matrix_log_self, -1);
+    rb_define_method(cMatrix, "sqrt", matrix_sqrt, -1);
+    rb_define_method(cMatrix, "sqrt!", matrix_sqrt_self, -1);
+    rb_define_method(cMatrix, "sin", matrix_sin, -1);
+    rb_define_method(cMatrix, "sin!", matrix_sin_self, -1);
+    rb_define_method(cMatrix, "cos", matrix_cos, -1);
+    rb_define_method(cMatrix, "cos!", matrix_cos_self, -1);
+    rb_define_method(cMatrix, "tanh", matrix_tanh, -1);
+    rb_define_method(cMatrix, "tanh!", matrix_tanh_self, -1);
+    rb_define_method(cMatrix, "sigmoid", matrix_sigmoid, -1);
+    rb_define_method(cMatrix, "sigmoid!", matrix_sigmoid_self, -1);
+    rb_define_method(cMatrix, "pow", matrix_pow, -1);
+    rb_define_method(cMatrix, "pow!", matrix_pow_self, -1);
+    rb_define_method(cMatrix, "clamp", matrix_clamp, -1);
+    rb_define_method(cMatrix, "clamp!", matrix_clamp_self, -1);
+    rb_define_method(cMatrix, "convert", matrix_to_standard, 0);
+    rb_define_method(cMatrix, "==", matrix_equal_to, 1);
+    rb_define_singleton_method(cMatrix, "convert", matrix_convert, 1);
     rb_define_module_function(cMatrix, "vstack", matrix_vstack, -1);
+    rb_define_module_function(cMatrix, "multi_dot", matrix_multi_dot, -1);
+    rb_define_module_function(cMatrix, "pairwise_distances", matrix_pairwise_distances, -1);
     rb_define_module_function(cMatrix, "hstack", matrix_hstack, -1);
     rb_define_module_function(cMatrix, "scalar", matrix_scalar, 2);
+    rb_define_module_function(cMatrix, "identity", matrix_identity, 1);
+    rb_define_module_function(cMatrix, "diagonal", matrix_new_diagonal, -1);
+    rb_define_module_function(cMatrix, "build", matrix_build, -1);
+    rb_define_module_function(cMatrix, "lines", matrix_lines, 2);
+    rb_define_module_function(cMatrix, "column_vector", matrix_new_column_vector, 1);
+    rb_define_module_function(cMatrix, "row_vector", matrix_new_row_vector, 1);
+    rb_define_method(cMatrix, "to_binary", matrix_to_binary, 0);
+    rb_define_method(cMatrix, "_dump", matrix_dump, 1);
+    rb_define_method(cMatrix, "save_npy", matrix_save_npy, 1);
+    rb_define_module_function(cMatrix, "from_binary", matrix_from_binary, 1);
+    rb_define_module_function(cMatrix, "_load", matrix_from_binary, 1);
+    rb_define_module_function(cMatrix, "load_npy", matrix_load_npy, 1);
+#ifdef FAST_MATRIX_MAPPED_FILE
+    rb_define_module_function(cMatrix, "mmap_file", matrix_mmap_file, 4);
+#endif
+#ifdef FAST_MATRIX_SHARED_MEMORY
+    rb_define_method(cMatrix, "freeze_shared", matrix_freeze_shared, 0);
+    rb_define_method(cMatrix, "shared_memory?", matrix_shared_memory, 0);
+#endif
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+    rb_define_module_function(cMatrix, "from_memory_view", matrix_from_memory_view, -1);
+    rb_define_module_function(cMatrix, "wrap_memory_view", matrix_wrap_memory_view, -1);
+    rb_memory_view_register(cMatrix, &matrix_memory_view_entry);
+#endif
 }
@@ -0,0 +1,92 @@
+#include "PointCloud/c_point_cloud.h"
+#include "Helper/c_array_operations.h"
+#include <math.h>
+
+void c_point_cloud_dot(int dim, int count, const double* A, const double* B, bool broadcast, double* R)
+{
+    fill_d_array(count, R, 0);
+    for(int c = 0; c < dim; ++c)
+    {
+        const double* a = A + c * count;
+        if(broadcast)
+        {
+            add_scaled_d_array_to_first(count, R, B[c], a);
+            continue;
+        }
+        const double* b = B + c * count;
+        for(int i = 0; i < count; ++i)
+            R[i] += a[i] * b[i];
+    }
+}
+
+// R = U * V' - W * Z' for the components of the cross product
+void cross_component(int count, const double* U, const double* W,
+    const double* B, int v, int z, bool broadcast, double* R)
+{
+    if(broadcast)
+    {
+        for(int i = 0; i < count; ++i)
+            R[i] = U[i] * B[v] - W[i] * B[z];
+        return;
+    }
+    const double* V = B + v * count;
+    const double* Z = B + z * count;
+    for(int i = 0; i < count; ++i)
+        R[i] = U[i] * V[i] - W[i] * Z[i];
+}
+
+// A, B, R - clouds of dimension 3
+void c_point_cloud_cross(int count, const double* A, const double* B, bool broadcast, double* R)
+{
+    const double* x = A;
+    const double* y = A + count;
+    const double* z = A + 2 * count;
+    cross_component(count, y, z, B, 2, 1, broadcast, R);
+    cross_component(count, z, x, B, 0, 2, broadcast, R + count);
+    cross_component(count, x, y, B, 1, 0, broadcast, R + 2 * count);
+}
+
+void c_point_cloud_distance(int dim, int count, const double* A, const double* B, bool broadcast, double* R)
+{
+    fill_d_array(count, R, 0);
+    for(int c = 0; c < dim; ++c)
+    {
+        const double* a = A + c * count;
+        if(broadcast)
+        {
+            double b = B[c];
+            for(int i = 0; i < count; ++i)
+                R[i] += (a[i] - b) * (a[i] - b);
+            continue;
+        }
+        const double* b = B + c * count;
+        for(int i = 0; i < count; ++i)
+            R[i] += (a[i] - b[i]) * (a[i] - b[i]);
+    }
+    for(int i = 0; i < count; ++i)
+        R[i] = sqrt(R[i]);
+}
+
+void c_point_cloud_magnitude(int dim, int count, const double* A, double* R)
+{
+    c_point_cloud_dot(dim, count, A, A, false, R);
+    for(int i = 0; i < count; ++i)
+        R[i] = sqrt(R[i]);
+}
+
+// zero points stay zero
+void c_point_cloud_normalize(int dim, int count, const double* A, double* R)
+{
+    double* scale = malloc(count * sizeof(double));
+    c_point_cloud_magnitude(dim, count, A, scale);
+    for(int i = 0; i < count; ++i)
+        scale[i] = scale[i] == 0 ? 0 : 1 / scale[i];
+    for(int c = 0; c < dim; ++c)
+    {
+        const double* a = A + c * count;
+        double* r = R + c * count;
+        for(int i = 0; i < count; ++i)
+            r[i] = a[i] * scale[i];
+    }
+    free(scale);
+}
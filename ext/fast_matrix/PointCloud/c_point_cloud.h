@@ -0,0 +1,29 @@
+#ifndef FAST_MATRIX_POINTCLOUD_C_POINT_CLOUD_H
+#define FAST_MATRIX_POINTCLOUD_C_POINT_CLOUD_H 1
+
+#include <stdbool.h>
+
+// count points of dimension dim stored by components (structure of arrays)
+//     count --->
+//   [ x0, x1, .., x(count-1)]
+// d [ y0, y1, .., y(count-1)]
+// | [ z0, z1, .., z(count-1)]
+// V
+// so the components form a matrix count x dim and kernels run along points
+struct point_cloud
+{
+    int dim;
+    int count;
+    double* data;
+};
+
+// the second operand B of the kernels is a cloud of the same size or
+// a single point if broadcast, then B holds its dim components
+
+void c_point_cloud_dot(int dim, int count, const double* A, const double* B, bool broadcast, double* R);
+void c_point_cloud_cross(int count, const double* A, const double* B, bool broadcast, double* R);
+void c_point_cloud_distance(int dim, int count, const double* A, const double* B, bool broadcast, double* R);
+void c_point_cloud_magnitude(int dim, int count, const double* A, double* R);
+void c_point_cloud_normalize(int dim, int count, const double* A, double* R);
+
+#endif /* FAST_MATRIX_POINTCLOUD_C_POINT_CLOUD_H */
@@ -0,0 +1,27 @@
+#ifndef FAST_MATRIX_POINTCLOUD_HELPER_H
+#define FAST_MATRIX_POINTCLOUD_HELPER_H 1
+
+#include "ruby.h"
+#include "PointCloud/c_point_cloud.h"
+
+inline struct point_cloud* get_point_cloud_from_rb_value(VALUE p)
+{
+	struct point_cloud* data;
+	TypedData_Get_Struct(p, struct point_cloud, &point_cloud_type, data);
+    return data;
+}
+
+inline void c_point_cloud_init(struct point_cloud* P, int dim, int count)
+{
+    P->dim = dim;
+    P->count = count;
+    P->data = malloc(dim * count * sizeof(double));
+}
+
+#define MAKE_POINT_CLOUD_AND_RB_VALUE(cloud_name, rb_value_name, dim, count)\
+struct point_cloud* cloud_name;									\
+VALUE rb_value_name = TypedData_Make_Struct(					\
+	cPointCloud, struct point_cloud, &point_cloud_type, cloud_name);\
+c_point_cloud_init(cloud_name, dim, count)
+
+#endif /* FAST_MATRIX_POINTCLOUD_HELPER_H */
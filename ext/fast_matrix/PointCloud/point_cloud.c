@@ -0,0 +1,267 @@
+#include "PointCloud/point_cloud.h"
+#include "PointCloud/c_point_cloud.h"
+#include "PointCloud/helper.h"
+#include "Matrix/matrix.h"
+#include "Matrix/errors.h"
+#include "Matrix/helper.h"
+#include "Vector/vector.h"
+#include "Vector/helper.h"
+#include "Helper/c_array_operations.h"
+#include "Helper/errors.h"
+
+VALUE cPointCloud;
+
+void point_cloud_free(void* data);
+size_t point_cloud_size(const void* data);
+
+const rb_data_type_t point_cloud_type =
+{
+    .wrap_struct_name = "point_cloud",
+    .function =
+    {
+        .dmark = NULL,
+        .dfree = point_cloud_free,
+        .dsize = point_cloud_size,
+    },
+    .data = NULL,
+    .flags = RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+void point_cloud_free(void* data)
+{
+    free(((struct point_cloud*)data)->data);
+    free(data);
+}
+
+size_t point_cloud_size(const void* data)
+{
+    const struct point_cloud* P = data;
+    return sizeof(struct point_cloud) + P->dim * P->count * sizeof(double);
+}
+
+VALUE point_cloud_alloc(VALUE self)
+{
+    struct point_cloud* P = malloc(sizeof(struct point_cloud));
+    P->dim = 0;
+    P->count = 0;
+    P->data = NULL;
+    return TypedData_Wrap_Struct(self, &point_cloud_type, P);
+}
+
+//  PointCloud.new(count, dim), all points are zero
+VALUE point_cloud_initialize(VALUE self, VALUE count, VALUE dim)
+{
+    int c = raise_rb_value_to_int(count);
+    int d = raise_rb_value_to_int(dim);
+    if(c <= 0 || d <= 0)
+        rb_raise(fm_eIndexError, "Size cannot be negative or zero");
+
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    free(P->data);
+    c_point_cloud_init(P, d, c);
+    fill_d_array(d * c, P->data, 0);
+    return self;
+}
+
+//  PointCloud[*vectors]
+VALUE point_cloud_from_vectors(int argc, VALUE* argv, VALUE obj)
+{
+    raise_check_no_arguments(argc);
+    for(int i = 0; i < argc; ++i)
+        raise_check_rbasic(argv[i], cVector, "vector");
+
+    int dim = get_vector_from_rb_value(argv[0])->n;
+    for(int i = 1; i < argc; ++i)
+        if(get_vector_from_rb_value(argv[i])->n != dim)
+            rb_raise(fm_eIndexError, "Rows of different size");
+
+    MAKE_POINT_CLOUD_AND_RB_VALUE(P, result, dim, argc);
+    for(int i = 0; i < argc; ++i)
+    {
+        const double* v = get_vector_from_rb_value(argv[i])->data;
+        for(int c = 0; c < dim; ++c)
+            P->data[c * argc + i] = v[c];
+    }
+    return result;
+}
+
+//  PointCloud.from_matrix(m), points are rows of m
+VALUE point_cloud_from_matrix(VALUE obj, VALUE matrix)
+{
+    raise_check_rbasic(matrix, cMatrix, "matrix");
+    struct matrix* M = get_matrix_from_rb_value(matrix);
+    MAKE_POINT_CLOUD_AND_RB_VALUE(P, result, M->m, M->n);
+    c_matrix_transpose(M->m, M->n, M->data, P->data);
+    return result;
+}
+
+VALUE point_cloud_to_matrix(VALUE self)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    MAKE_MATRIX_AND_RB_VALUE(M, result, P->dim, P->count);
+    c_matrix_transpose(P->count, P->dim, P->data, M->data);
+    return result;
+}
+
+VALUE point_cloud_count(VALUE self)
+{
+    return INT2NUM(get_point_cloud_from_rb_value(self)->count);
+}
+
+VALUE point_cloud_dim(VALUE self)
+{
+    return INT2NUM(get_point_cloud_from_rb_value(self)->dim);
+}
+
+VALUE point_cloud_get(VALUE self, VALUE index)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    int i = raise_rb_value_to_int(index);
+    i = (i < 0) ? P->count + i : i;
+    if(i < 0 || i >= P->count)
+        return Qnil;
+
+    MAKE_VECTOR_AND_RB_VALUE(V, result, P->dim);
+    for(int c = 0; c < P->dim; ++c)
+        V->data[c] = P->data[c * P->count + i];
+    return result;
+}
+
+VALUE point_cloud_set(VALUE self, VALUE index, VALUE vector)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    int i = raise_rb_value_to_int(index);
+    raise_check_rbasic(vector, cVector, "vector");
+    struct vector* V = get_vector_from_rb_value(vector);
+    i = (i < 0) ? P->count + i : i;
+    if(i < 0 || i >= P->count)
+        rb_raise(fm_eIndexError, "Index out of range");
+    if(V->n != P->dim)
+        rb_raise(fm_eIndexError, "Vector size differs from point dimension");
+
+    for(int c = 0; c < P->dim; ++c)
+        P->data[c * P->count + i] = V->data[c];
+    return vector;
+}
+
+//  data of the second operand, a cloud of the size of P or a single point
+const double* point_cloud_operand(const struct point_cloud* P, VALUE other, bool* broadcast)
+{
+    if(!RB_SPECIAL_CONST_P(other) && RBASIC_CLASS(other) == cVector)
+    {
+        struct vector* V = get_vector_from_rb_value(other);
+        if(V->n != P->dim)
+            rb_raise(fm_eIndexError, "Vector size differs from point dimension");
+        *broadcast = true;
+        return V->data;
+    }
+
+    raise_check_rbasic(other, cPointCloud, "point cloud");
+    struct point_cloud* B = get_point_cloud_from_rb_value(other);
+    if(B->dim != P->dim || B->count != P->count)
+        rb_raise(fm_eIndexError, "Point clouds of different size");
+    *broadcast = false;
+    return B->data;
+}
+
+VALUE point_cloud_copy(VALUE self)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    MAKE_POINT_CLOUD_AND_RB_VALUE(R, result, P->dim, P->count);
+    copy_d_array(P->dim * P->count, P->data, R->data);
+    return result;
+}
+
+VALUE point_cloud_dot(VALUE self, VALUE other)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    bool broadcast;
+    const double* B = point_cloud_operand(P, other, &broadcast);
+    MAKE_VECTOR_AND_RB_VALUE(R, result, P->count);
+    c_point_cloud_dot(P->dim, P->count, P->data, B, broadcast, R->data);
+    return result;
+}
+
+VALUE point_cloud_cross(VALUE self, VALUE other)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    if(P->dim != 3)
+        rb_raise(fm_eIndexError, "Cross product needs points of dimension 3");
+    bool broadcast;
+    const double* B = point_cloud_operand(P, other, &broadcast);
+    MAKE_POINT_CLOUD_AND_RB_VALUE(R, result, 3, P->count);
+    c_point_cloud_cross(P->count, P->data, B, broadcast, R->data);
+    return result;
+}
+
+VALUE point_cloud_distance(VALUE self, VALUE other)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    bool broadcast;
+    const double* B = point_cloud_operand(P, other, &broadcast);
+    MAKE_VECTOR_AND_RB_VALUE(R, result, P->count);
+    c_point_cloud_distance(P->dim, P->count, P->data, B, broadcast, R->data);
+    return result;
+}
+
+VALUE point_cloud_magnitude(VALUE self)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    MAKE_VECTOR_AND_RB_VALUE(R, result, P->count);
+    c_point_cloud_magnitude(P->dim, P->count, P->data, R->data);
+    return result;
+}
+
+VALUE point_cloud_normalize(VALUE self)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    MAKE_POINT_CLOUD_AND_RB_VALUE(R, result, P->dim, P->count);
+    c_point_cloud_normalize(P->dim, P->count, P->data, R->data);
+    return result;
+}
+
+VALUE point_cloud_normalize_self(VALUE self)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    c_point_cloud_normalize(P->dim, P->count, P->data, P->data);
+    return self;
+}
+
+//  apply(matrix), every point p becomes matrix * p
+VALUE point_cloud_apply(VALUE self, VALUE matrix)
+{
+    struct point_cloud* P = get_point_cloud_from_rb_value(self);
+    raise_check_rbasic(matrix, cMatrix, "matrix");
+    struct matrix* M = get_matrix_from_rb_value(matrix);
+    if(M->m != P->dim)
+        rb_raise(fm_eIndexError, "Matrix columns differs from point dimension");
+
+    MAKE_POINT_CLOUD_AND_RB_VALUE(R, result, M->n, P->count);
+    c_matrix_strassen(M->n, M->m, P->count, M->data, P->data, R->data);
+    return result;
+}
+
+void init_fm_point_cloud()
+{
+    VALUE  mod = rb_define_module("FastMatrix");
+    cPointCloud = rb_define_class_under(mod, "PointCloud", rb_cData);
+    rb_define_alloc_func(cPointCloud, point_cloud_alloc);
+
+    rb_define_method(cPointCloud, "initialize", point_cloud_initialize, 2);
+    rb_define_method(cPointCloud, "count", point_cloud_count, 0);
+    rb_define_method(cPointCloud, "dim", point_cloud_dim, 0);
+    rb_define_method(cPointCloud, "[]", point_cloud_get, 1);
+    rb_define_method(cPointCloud, "[]=", point_cloud_set, 2);
+    rb_define_method(cPointCloud, "to_matrix", point_cloud_to_matrix, 0);
+    rb_define_method(cPointCloud, "clone", point_cloud_copy, 0);
+    rb_define_method(cPointCloud, "dot", point_cloud_dot, 1);
+    rb_define_method(cPointCloud, "cross", point_cloud_cross, 1);
+    rb_define_method(cPointCloud, "distance", point_cloud_distance, 1);
+    rb_define_method(cPointCloud, "magnitude", point_cloud_magnitude, 0);
+    rb_define_method(cPointCloud, "normalize", point_cloud_normalize, 0);
+    rb_define_method(cPointCloud, "normalize!", point_cloud_normalize_self, 0);
+    rb_define_method(cPointCloud, "apply", point_cloud_apply, 1);
+
+    rb_define_singleton_method(cPointCloud, "[]", point_cloud_from_vectors, -1);
+    rb_define_singleton_method(cPointCloud, "from_matrix", point_cloud_from_matrix, 1);
+}
@@ -0,0 +1,10 @@
+#ifndef FAST_MATRIX_POINTCLOUD_H
+#define FAST_MATRIX_POINTCLOUD_H 1
+
+#include "ruby.h"
+
+extern VALUE cPointCloud;
+extern const rb_data_type_t point_cloud_type;
+void init_fm_point_cloud();
+
+#endif /* FAST_MATRIX_POINTCLOUD_H */
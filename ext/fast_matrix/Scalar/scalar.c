@@ -0,0 +1,93 @@
+#include "Scalar/scalar.h"
+#include "Matrix/matrix.h"
+#include "Matrix/errors.h"
+#include "Matrix/helper.h"
+#include "Vector/vector.h"
+#include "Vector/helper.h"
+#include "Helper/c_array_operations.h"
+#include "Helper/errors.h"
+
+VALUE cScalar;
+
+//  numeric-left operand of Matrix and Vector returned by coerce,
+//  the other methods of Scalar are defined in ruby
+VALUE scalar_new(VALUE value)
+{
+    VALUE scalar = rb_obj_alloc(cScalar);
+    rb_ivar_set(scalar, rb_intern("@value"), value);
+    return scalar;
+}
+
+VALUE scalar_value(VALUE self)
+{
+    return rb_ivar_get(self, rb_intern("@value"));
+}
+
+//  Matrix#coerce and Vector#coerce
+VALUE scalar_coerce(VALUE self, VALUE other)
+{
+    if(!RTEST(rb_obj_is_kind_of(other, rb_cNumeric)))
+        rb_raise(fm_eTypeError, "%"PRIsVALUE" can't be coerced into %"PRIsVALUE,
+            rb_obj_class(self), rb_obj_class(other));
+    return rb_assoc_new(scalar_new(other), self);
+}
+
+VALUE scalar_multiply(VALUE self, VALUE other)
+{
+    VALUE value = scalar_value(self);
+    if(RB_SPECIAL_CONST_P(other))
+        return scalar_new(rb_funcall(value, '*', 1, other));
+
+    if(RTEST(rb_obj_is_kind_of(other, cMatrix)))
+    {
+        double d = raise_rb_value_to_double(value);
+        struct matrix* A = get_matrix_from_rb_value(other);
+        MAKE_MATRIX_AND_RB_VALUE(R, result, A->m, A->n);
+        multiply_d_array_to_result(A->m * A->n, A->data, d, R->data);
+        return result;
+    }
+    if(RTEST(rb_obj_is_kind_of(other, cVector)))
+    {
+        double d = raise_rb_value_to_double(value);
+        struct vector* A = get_vector_from_rb_value(other);
+        MAKE_VECTOR_AND_RB_VALUE(R, result, A->n);
+        multiply_d_array_to_result(A->n, A->data, d, R->data);
+        return result;
+    }
+    return scalar_new(rb_funcall(value, '*', 1, other));
+}
+
+//  value / matrix is value multiplied by the inverse matrix
+VALUE scalar_division(VALUE self, VALUE other)
+{
+    VALUE value = scalar_value(self);
+    if(RB_SPECIAL_CONST_P(other))
+        return scalar_new(rb_funcall(value, '/', 1, other));
+
+    if(RTEST(rb_obj_is_kind_of(other, cMatrix)))
+    {
+        double d = raise_rb_value_to_double(value);
+        struct matrix* A = get_matrix_from_rb_value(other);
+        raise_check_square_matrix(A);
+        MAKE_MATRIX_AND_RB_VALUE(R, result, A->n, A->n);
+        if(!c_matrix_inverse(R->n, A->data, R->data))
+            rb_raise(fm_eIndexError, "The discriminant is zero");
+        multiply_d_array(R->n * R->n, R->data, d);
+        return result;
+    }
+    if(RTEST(rb_obj_is_kind_of(other, cVector)))
+        rb_raise(rb_path2class("FastMatrix::OperationNotDefinedError"), "%"PRIsVALUE"/%"PRIsVALUE,
+            rb_obj_class(value), rb_obj_class(other));
+    return scalar_new(rb_funcall(value, '/', 1, other));
+}
+
+void init_fm_scalar()
+{
+    VALUE  mod = rb_define_module("FastMatrix");
+	cScalar = rb_define_class_under(mod, "Scalar", rb_cNumeric);
+
+    rb_define_method(cScalar, "*", scalar_multiply, 1);
+    rb_define_method(cScalar, "/", scalar_division, 1);
+    rb_define_method(cMatrix, "coerce", scalar_coerce, 1);
+    rb_define_method(cVector, "coerce", scalar_coerce, 1);
+}
@@ -0,0 +1,9 @@
+#ifndef FAST_MATRIX_SCALAR_H
+#define FAST_MATRIX_SCALAR_H 1
+
+#include "ruby.h"
+
+extern VALUE cScalar;
+void init_fm_scalar();
+
+#endif /* FAST_MATRIX_SCALAR_H */
@@ -0,0 +1,194 @@
+#include "SparseMatrix/c_sparse.h"
+#include "Helper/c_array_operations.h"
+
+int c_sparse_major_count(const struct sparse_matrix* S)
+{
+    return S->csc ? S->m : S->n;
+}
+
+int c_sparse_minor_count(const struct sparse_matrix* S)
+{
+    return S->csc ? S->n : S->m;
+}
+
+// stable counting sort of count triplets by the major index into lines
+void c_sparse_compress(int lines, int count, const int* major, const int* minor, const double* values,
+    int* offsets, int* indices, double* data)
+{
+    for(int i = 0; i <= lines; ++i)
+        offsets[i] = 0;
+    for(int k = 0; k < count; ++k)
+        ++offsets[major[k] + 1];
+    for(int i = 0; i < lines; ++i)
+        offsets[i + 1] += offsets[i];
+
+    int* next = malloc(lines * sizeof(int));
+    for(int i = 0; i < lines; ++i)
+        next[i] = offsets[i];
+    for(int k = 0; k < count; ++k)
+    {
+        int pos = next[major[k]]++;
+        indices[pos] = minor[k];
+        data[pos] = values[k];
+    }
+    free(next);
+}
+
+// CSR <-> CSC, the indices of the result are sorted
+//  lines  - number of major lines of the input
+//  others - number of minor lines of the input
+void c_sparse_transpose(int lines, int others, const int* offsets, const int* indices, const double* data,
+    int* t_offsets, int* t_indices, double* t_data)
+{
+    for(int i = 0; i <= others; ++i)
+        t_offsets[i] = 0;
+    for(int k = 0; k < offsets[lines]; ++k)
+        ++t_offsets[indices[k] + 1];
+    for(int i = 0; i < others; ++i)
+        t_offsets[i + 1] += t_offsets[i];
+
+    int* next = malloc((others + 1) * sizeof(int));
+    for(int i = 0; i < others; ++i)
+        next[i] = t_offsets[i];
+    for(int i = 0; i < lines; ++i)
+        for(int k = offsets[i]; k < offsets[i + 1]; ++k)
+        {
+            int pos = next[indices[k]]++;
+            t_indices[pos] = i;
+            t_data[pos] = data[k];
+        }
+    free(next);
+}
+
+// sum adjacent elements with equal indices in sorted lines, returns the new number of elements
+int c_sparse_sum_duplicates(int lines, int* offsets, int* indices, double* data)
+{
+    int nnz = 0;
+    int begin = 0;
+    for(int i = 0; i < lines; ++i)
+    {
+        int end = offsets[i + 1];
+        int line_begin = nnz;
+        for(int k = begin; k < end; ++k)
+        {
+            if(nnz > line_begin && indices[nnz - 1] == indices[k])
+                data[nnz - 1] += data[k];
+            else
+            {
+                indices[nnz] = indices[k];
+                data[nnz] = data[k];
+                ++nnz;
+            }
+        }
+        offsets[i + 1] = nnz;
+        begin = end;
+    }
+    return nnz;
+}
+
+int c_sparse_count_nonzero(int len, const double* A)
+{
+    int count = 0;
+    for(int i = 0; i < len; ++i)
+        if(A[i] != 0)
+            ++count;
+    return count;
+}
+
+// A - dense matrix m x n
+void c_sparse_from_dense(int m, int n, const double* A, bool csc, int* offsets, int* indices, double* data)
+{
+    int lines = csc ? m : n;
+    int others = csc ? n : m;
+    int nnz = 0;
+    offsets[0] = 0;
+    for(int i = 0; i < lines; ++i)
+    {
+        for(int j = 0; j < others; ++j)
+        {
+            double v = csc ? A[i + m * j] : A[j + m * i];
+            if(v != 0)
+            {
+                indices[nnz] = j;
+                data[nnz] = v;
+                ++nnz;
+            }
+        }
+        offsets[i + 1] = nnz;
+    }
+}
+
+void c_sparse_to_dense(const struct sparse_matrix* S, double* A)
+{
+    fill_d_array(S->m * S->n, A, 0);
+    for(int i = 0; i < c_sparse_major_count(S); ++i)
+        for(int k = S->offsets[i]; k < S->offsets[i + 1]; ++k)
+        {
+            if(S->csc)
+                A[i + S->m * S->indices[k]] = S->data[k];
+            else
+                A[S->indices[k] + S->m * i] = S->data[k];
+        }
+}
+
+double c_sparse_get(const struct sparse_matrix* S, int row, int column)
+{
+    int line = S->csc ? column : row;
+    int idx = S->csc ? row : column;
+
+    int lo = S->offsets[line];
+    int hi = S->offsets[line + 1];
+    while(lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if(S->indices[mid] < idx)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if(lo < S->offsets[line + 1] && S->indices[lo] == idx)
+        return S->data[lo];
+    return 0;
+}
+
+// R = S * V, V has S->m elements, R has S->n elements
+void c_sparse_vector_multiply(const struct sparse_matrix* S, const double* V, double* R)
+{
+    if(!S->csc)
+    {
+        for(int i = 0; i < S->n; ++i)
+        {
+            double sum = 0;
+            for(int k = S->offsets[i]; k < S->offsets[i + 1]; ++k)
+                sum += S->data[k] * V[S->indices[k]];
+            R[i] = sum;
+        }
+        return;
+    }
+
+    fill_d_array(S->n, R, 0);
+    for(int j = 0; j < S->m; ++j)
+    {
+        double v = V[j];
+        for(int k = S->offsets[j]; k < S->offsets[j + 1]; ++k)
+            R[S->indices[k]] += S->data[k] * v;
+    }
+}
+
+// R = S * B, B is dense matrix p x S->m, R is dense matrix p x S->n
+//  each element of S adds a scaled row of B to a row of R
+void c_sparse_dense_multiply(const struct sparse_matrix* S, int p, const double* B, double* R)
+{
+    fill_d_array(p * S->n, R, 0);
+    for(int i = 0; i < c_sparse_major_count(S); ++i)
+        for(int k = S->offsets[i]; k < S->offsets[i + 1]; ++k)
+        {
+            int row = S->csc ? S->indices[k] : i;
+            int column = S->csc ? i : S->indices[k];
+            double v = S->data[k];
+            double* r = R + p * row;
+            const double* b = B + p * column;
+            for(int j = 0; j < p; ++j)
+                r[j] += v * b[j];
+        }
+}
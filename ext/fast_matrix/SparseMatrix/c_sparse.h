@@ -0,0 +1,38 @@
+#ifndef FAST_MATRIX_SPARSEMATRIX_C_SPARSE_H
+#define FAST_MATRIX_SPARSEMATRIX_C_SPARSE_H 1
+
+#include <stdbool.h>
+
+// compressed sparse rows (CSR) or columns (CSC)
+//  major lines are rows for CSR and columns for CSC,
+//  elements of the line i are data[offsets[i]..offsets[i + 1]),
+//  indices holds their minor indices in ascending order
+struct sparse_matrix
+{
+    int m;
+    int n;
+
+    bool csc;
+    int nnz;
+    int* offsets;
+    int* indices;
+    double* data;
+};
+
+int c_sparse_major_count(const struct sparse_matrix* S);
+int c_sparse_minor_count(const struct sparse_matrix* S);
+
+void c_sparse_compress(int lines, int count, const int* major, const int* minor, const double* values,
+    int* offsets, int* indices, double* data);
+void c_sparse_transpose(int lines, int others, const int* offsets, const int* indices, const double* data,
+    int* t_offsets, int* t_indices, double* t_data);
+int c_sparse_sum_duplicates(int lines, int* offsets, int* indices, double* data);
+int c_sparse_count_nonzero(int len, const double* A);
+void c_sparse_from_dense(int m, int n, const double* A, bool csc, int* offsets, int* indices, double* data);
+void c_sparse_to_dense(const struct sparse_matrix* S, double* A);
+double c_sparse_get(const struct sparse_matrix* S, int row, int column);
+
+void c_sparse_vector_multiply(const struct sparse_matrix* S, const double* V, double* R);
+void c_sparse_dense_multiply(const struct sparse_matrix* S, int p, const double* B, double* R);
+
+#endif /* FAST_MATRIX_SPARSEMATRIX_C_SPARSE_H */
@@ -0,0 +1,35 @@
+#ifndef FAST_MATRIX_SPARSEMATRIX_HELPER_H
+#define FAST_MATRIX_SPARSEMATRIX_HELPER_H 1
+
+#include "ruby.h"
+#include "SparseMatrix/c_sparse.h"
+#include "Helper/errors.h"
+
+inline struct sparse_matrix* get_sparse_from_rb_value(VALUE s)
+{
+	struct sparse_matrix* data;
+	TypedData_Get_Struct(s, struct sparse_matrix, &sparse_type, data);
+    if(data->offsets == NULL)
+        rb_raise(fm_eTypeError, "Uninitialized sparse matrix");
+    return data;
+}
+
+//  allocates the arrays for nnz elements
+inline void c_sparse_init(struct sparse_matrix* sprs, int m, int n, bool csc, int nnz)
+{
+    sprs->m = m;
+    sprs->n = n;
+    sprs->csc = csc;
+    sprs->nnz = nnz;
+    sprs->offsets = malloc((c_sparse_major_count(sprs) + 1) * sizeof(int));
+    sprs->indices = malloc((nnz > 0 ? nnz : 1) * sizeof(int));
+    sprs->data = malloc((nnz > 0 ? nnz : 1) * sizeof(double));
+}
+
+#define MAKE_SPARSE_AND_RB_VALUE(sparse_name, rb_value_name, m, n, csc, nnz)\
+struct sparse_matrix* sparse_name;						\
+VALUE rb_value_name = TypedData_Make_Struct(			\
+	cSparseMatrix, struct sparse_matrix, &sparse_type, sparse_name);\
+c_sparse_init(sparse_name, m, n, csc, nnz)
+
+#endif /* FAST_MATRIX_SPARSEMATRIX_HELPER_H */
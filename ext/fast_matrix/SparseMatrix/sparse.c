@@ -0,0 +1,331 @@
+#include "SparseMatrix/sparse.h"
+#include "SparseMatrix/c_sparse.h"
+#include "SparseMatrix/helper.h"
+#include "Matrix/matrix.h"
+#include "Matrix/helper.h"
+#include "Vector/vector.h"
+#include "Vector/helper.h"
+#include "Helper/c_array_operations.h"
+#include "Helper/errors.h"
+
+VALUE cSparseMatrix;
+
+void sparse_free(void* data);
+size_t sparse_size(const void* data);
+
+const rb_data_type_t sparse_type =
+{
+    .wrap_struct_name = "sparse_matrix",
+    .function =
+    {
+        .dmark = NULL,
+        .dfree = sparse_free,
+        .dsize = sparse_size,
+    },
+    .data = NULL,
+    .flags = RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+void sparse_free(void* data)
+{
+    struct sparse_matrix* S = data;
+    free(S->offsets);
+    free(S->indices);
+    free(S->data);
+    free(data);
+}
+
+size_t sparse_size(const void* data)
+{
+    const struct sparse_matrix* S = data;
+    if(S->offsets == NULL)
+        return sizeof(struct sparse_matrix);
+    return sizeof(struct sparse_matrix) + (c_sparse_major_count(S) + 1) * sizeof(int)
+        + S->nnz * (sizeof(int) + sizeof(double));
+}
+
+VALUE sparse_alloc(VALUE self)
+{
+	struct sparse_matrix* S = malloc(sizeof(struct sparse_matrix));
+    S->m = 0;
+    S->n = 0;
+    S->csc = false;
+    S->nnz = 0;
+    S->offsets = NULL;
+    S->indices = NULL;
+    S->data = NULL;
+	return TypedData_Wrap_Struct(self, &sparse_type, S);
+}
+
+//  :csr (by default) or :csc
+bool raise_rb_value_to_csc(int argc, VALUE* argv, int idx)
+{
+    if(argc <= idx || argv[idx] == ID2SYM(rb_intern("csr")))
+        return false;
+    if(argv[idx] == ID2SYM(rb_intern("csc")))
+        return true;
+    rb_raise(fm_eTypeError, "Unknown sparse format");
+    return false;
+}
+
+void raise_check_sparse_sizes(int m, int n)
+{
+    if(m <= 0 || n <= 0)
+        rb_raise(fm_eIndexError, "Size cannot be negative or zero");
+}
+
+//  SparseMatrix.from_triplets(row_count, column_count, rows, columns, values, format = :csr),
+//  values with equal indices are summed
+VALUE sparse_from_triplets(int argc, VALUE *argv, VALUE obj)
+{
+    if(argc != 5 && argc != 6)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    int n = raise_rb_value_to_int(argv[0]);
+    int m = raise_rb_value_to_int(argv[1]);
+    raise_check_sparse_sizes(m, n);
+    VALUE rows = rb_Array(argv[2]);
+    VALUE columns = rb_Array(argv[3]);
+    VALUE values = rb_Array(argv[4]);
+    bool csc = raise_rb_value_to_csc(argc, argv, 5);
+
+    int count = RARRAY_LEN(rows);
+    if(RARRAY_LEN(columns) != count || RARRAY_LEN(values) != count)
+        rb_raise(fm_eIndexError, "Triplets of different size");
+    for(int k = 0; k < count; ++k)
+    {
+        raise_check_range(raise_rb_value_to_int(RARRAY_AREF(rows, k)), 0, n);
+        raise_check_range(raise_rb_value_to_int(RARRAY_AREF(columns, k)), 0, m);
+        raise_rb_value_to_double(RARRAY_AREF(values, k));
+    }
+
+    int size = count > 0 ? count : 1;
+    int* major = malloc(size * sizeof(int));
+    int* minor = malloc(size * sizeof(int));
+    double* v = malloc(size * sizeof(double));
+    for(int k = 0; k < count; ++k)
+    {
+        int row = FIX2INT(RARRAY_AREF(rows, k));
+        int column = FIX2INT(RARRAY_AREF(columns, k));
+        major[k] = csc ? column : row;
+        minor[k] = csc ? row : column;
+        v[k] = NUM2DBL(RARRAY_AREF(values, k));
+    }
+
+    MAKE_SPARSE_AND_RB_VALUE(S, result, m, n, csc, count);
+    int lines = c_sparse_major_count(S);
+    int others = c_sparse_minor_count(S);
+
+    //  compressing by the minor index and transposing sorts the indices of lines
+    int* offsets = malloc((others + 1) * sizeof(int));
+    int* indices = malloc(size * sizeof(int));
+    double* data = malloc(size * sizeof(double));
+    c_sparse_compress(others, count, minor, major, v, offsets, indices, data);
+    c_sparse_transpose(others, lines, offsets, indices, data, S->offsets, S->indices, S->data);
+    S->nnz = c_sparse_sum_duplicates(lines, S->offsets, S->indices, S->data);
+
+    free(offsets);
+    free(indices);
+    free(data);
+    free(major);
+    free(minor);
+    free(v);
+    return result;
+}
+
+//  SparseMatrix.from_dense(matrix, format = :csr)
+VALUE sparse_from_dense(int argc, VALUE *argv, VALUE obj)
+{
+    if(argc != 1 && argc != 2)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    raise_check_rbasic(argv[0], cMatrix, "matrix");
+    bool csc = raise_rb_value_to_csc(argc, argv, 1);
+	struct matrix* A = get_matrix_from_rb_value(argv[0]);
+
+    int nnz = c_sparse_count_nonzero(A->m * A->n, A->data);
+    MAKE_SPARSE_AND_RB_VALUE(S, result, A->m, A->n, csc, nnz);
+    c_sparse_from_dense(A->m, A->n, A->data, csc, S->offsets, S->indices, S->data);
+    return result;
+}
+
+VALUE sparse_row_count(VALUE self)
+{
+    return INT2NUM(get_sparse_from_rb_value(self)->n);
+}
+
+VALUE sparse_column_count(VALUE self)
+{
+    return INT2NUM(get_sparse_from_rb_value(self)->m);
+}
+
+VALUE sparse_nnz(VALUE self)
+{
+    return INT2NUM(get_sparse_from_rb_value(self)->nnz);
+}
+
+VALUE sparse_format(VALUE self)
+{
+    return ID2SYM(rb_intern(get_sparse_from_rb_value(self)->csc ? "csc" : "csr"));
+}
+
+VALUE sparse_get(VALUE self, VALUE row, VALUE column)
+{
+    int m = raise_rb_value_to_int(column);
+    int n = raise_rb_value_to_int(row);
+	struct sparse_matrix* S = get_sparse_from_rb_value(self);
+
+    m = (m < 0) ? S->m + m : m;
+    n = (n < 0) ? S->n + n : n;
+
+    if(m < 0 || n < 0 || n >= S->n || m >= S->m)
+        return Qnil;
+
+    return DBL2NUM(c_sparse_get(S, n, m));
+}
+
+//  [rows, columns, values] of the stored elements
+VALUE sparse_to_triplets(VALUE self)
+{
+	struct sparse_matrix* S = get_sparse_from_rb_value(self);
+    VALUE rows = rb_ary_new_capa(S->nnz);
+    VALUE columns = rb_ary_new_capa(S->nnz);
+    VALUE values = rb_ary_new_capa(S->nnz);
+    for(int i = 0; i < c_sparse_major_count(S); ++i)
+        for(int k = S->offsets[i]; k < S->offsets[i + 1]; ++k)
+        {
+            rb_ary_push(rows, INT2NUM(S->csc ? S->indices[k] : i));
+            rb_ary_push(columns, INT2NUM(S->csc ? i : S->indices[k]));
+            rb_ary_push(values, DBL2NUM(S->data[k]));
+        }
+    return rb_ary_new_from_args(3, rows, columns, values);
+}
+
+VALUE sparse_to_matrix(VALUE self)
+{
+	struct sparse_matrix* S = get_sparse_from_rb_value(self);
+    MAKE_MATRIX_AND_RB_VALUE(R, result, S->m, S->n);
+    c_sparse_to_dense(S, R->data);
+    return result;
+}
+
+//  only for matrices with one row or one column
+VALUE sparse_to_vector(VALUE self)
+{
+	struct sparse_matrix* S = get_sparse_from_rb_value(self);
+    if(S->m != 1 && S->n != 1)
+        rb_raise(fm_eIndexError, "Matrix must have one row or one column");
+    MAKE_VECTOR_AND_RB_VALUE(R, result, S->m * S->n);
+    c_sparse_to_dense(S, R->data);
+    return result;
+}
+
+//  the same arrays, other is transposed if format differs
+VALUE sparse_copy_with_format(VALUE self, bool transposed, bool csc)
+{
+	struct sparse_matrix* S = get_sparse_from_rb_value(self);
+    int m = transposed ? S->n : S->m;
+    int n = transposed ? S->m : S->n;
+    MAKE_SPARSE_AND_RB_VALUE(R, result, m, n, csc, S->nnz);
+
+    int lines = c_sparse_major_count(S);
+    if(S->csc != csc && !transposed)
+    {
+        c_sparse_transpose(lines, c_sparse_minor_count(S), S->offsets, S->indices, S->data,
+            R->offsets, R->indices, R->data);
+        return result;
+    }
+    memcpy(R->offsets, S->offsets, (lines + 1) * sizeof(int));
+    memcpy(R->indices, S->indices, S->nnz * sizeof(int));
+    copy_d_array(S->nnz, S->data, R->data);
+    return result;
+}
+
+VALUE sparse_copy(VALUE self)
+{
+    return sparse_copy_with_format(self, false, get_sparse_from_rb_value(self)->csc);
+}
+
+//  CSR of the matrix is CSC of the transposed one
+VALUE sparse_transpose(VALUE self)
+{
+    return sparse_copy_with_format(self, true, !get_sparse_from_rb_value(self)->csc);
+}
+
+VALUE sparse_to_csr(VALUE self)
+{
+    return sparse_copy_with_format(self, false, false);
+}
+
+VALUE sparse_to_csc(VALUE self)
+{
+    return sparse_copy_with_format(self, false, true);
+}
+
+VALUE sparse_multiply_sv(VALUE self, VALUE other)
+{
+	struct sparse_matrix* S = get_sparse_from_rb_value(self);
+	struct vector* V = get_vector_from_rb_value(other);
+    if(S->m != V->n)
+        rb_raise(fm_eIndexError, "Matrix columns differs from vector size");
+
+    MAKE_VECTOR_AND_RB_VALUE(R, result, S->n);
+    c_sparse_vector_multiply(S, V->data, R->data);
+    return result;
+}
+
+VALUE sparse_multiply_sm(VALUE self, VALUE other)
+{
+	struct sparse_matrix* S = get_sparse_from_rb_value(self);
+	struct matrix* B = get_matrix_from_rb_value(other);
+    if(S->m != B->n)
+        rb_raise(fm_eIndexError, "First columns differs from second rows");
+
+    MAKE_MATRIX_AND_RB_VALUE(R, result, B->m, S->n);
+    c_sparse_dense_multiply(S, B->m, B->data, R->data);
+    return result;
+}
+
+VALUE sparse_multiply_sn(VALUE self, VALUE value)
+{
+    double d = raise_rb_value_to_double(value);
+    VALUE result = sparse_copy(self);
+	struct sparse_matrix* R = get_sparse_from_rb_value(result);
+    multiply_d_array(R->nnz, R->data, d);
+    return result;
+}
+
+VALUE sparse_multiply(VALUE self, VALUE v)
+{
+    if(RB_FLOAT_TYPE_P(v) || FIXNUM_P(v)
+        || RB_TYPE_P(v, T_BIGNUM))
+        return sparse_multiply_sn(self, v);
+    if(RB_SPECIAL_CONST_P(v))
+        rb_raise(fm_eTypeError, "Invalid klass for multiply");
+    if(RBASIC_CLASS(v) == cMatrix)
+        return sparse_multiply_sm(self, v);
+    if(RBASIC_CLASS(v) == cVector)
+        return sparse_multiply_sv(self, v);
+    rb_raise(fm_eTypeError, "Invalid klass for multiply");
+}
+
+void init_fm_sparse()
+{
+    VALUE  mod = rb_define_module("FastMatrix");
+	cSparseMatrix = rb_define_class_under(mod, "SparseMatrix", rb_cData);
+	rb_define_alloc_func(cSparseMatrix, sparse_alloc);
+
+    rb_define_method(cSparseMatrix, "row_count", sparse_row_count, 0);
+    rb_define_method(cSparseMatrix, "column_count", sparse_column_count, 0);
+    rb_define_method(cSparseMatrix, "nnz", sparse_nnz, 0);
+    rb_define_method(cSparseMatrix, "format", sparse_format, 0);
+    rb_define_method(cSparseMatrix, "[]", sparse_get, 2);
+    rb_define_method(cSparseMatrix, "to_triplets", sparse_to_triplets, 0);
+    rb_define_method(cSparseMatrix, "to_matrix", sparse_to_matrix, 0);
+    rb_define_method(cSparseMatrix, "to_vector", sparse_to_vector, 0);
+    rb_define_method(cSparseMatrix, "clone", sparse_copy, 0);
+    rb_define_method(cSparseMatrix, "transpose", sparse_transpose, 0);
+    rb_define_method(cSparseMatrix, "to_csr", sparse_to_csr, 0);
+    rb_define_method(cSparseMatrix, "to_csc", sparse_to_csc, 0);
+    rb_define_method(cSparseMatrix, "*", sparse_multiply, 1);
+    rb_define_module_function(cSparseMatrix, "from_triplets", sparse_from_triplets, -1);
+    rb_define_module_function(cSparseMatrix, "from_dense", sparse_from_dense, -1);
+}
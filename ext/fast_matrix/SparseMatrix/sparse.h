@@ -0,0 +1,10 @@
+#ifndef FAST_MATRIX_SPARSEMATRIX_H
+#define FAST_MATRIX_SPARSEMATRIX_H 1
+
+#include "ruby.h"
+
+extern VALUE cSparseMatrix;
+extern const rb_data_type_t sparse_type;
+void init_fm_sparse();
+
+#endif /* FAST_MATRIX_SPARSEMATRIX_H */
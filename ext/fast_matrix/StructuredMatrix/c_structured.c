@@ -0,0 +1,332 @@
+#include "StructuredMatrix/c_structured.h"
+#include "Matrix/c_matrix.h"
+#include "Helper/c_array_operations.h"
+
+int c_structured_length(enum structure kind, int n, int lower, int upper)
+{
+    switch(kind)
+    {
+    case STRUCTURE_DIAGONAL:
+        return n;
+    case STRUCTURE_BANDED:
+        return n * (lower + upper + 1);
+    default:
+        return n * (n + 1) / 2;
+    }
+}
+
+// stored elements of the row i are data[shift + j] for j in [begin, end),
+// for STRUCTURE_SYMMETRIC these are elements of the lower triangle
+int c_structured_row(const struct structured_matrix* S, int i, int* begin, int* end)
+{
+    switch(S->kind)
+    {
+    case STRUCTURE_DIAGONAL:
+        *begin = i;
+        *end = i + 1;
+        return 0;
+    case STRUCTURE_UPPER:
+        *begin = i;
+        *end = S->n;
+        return i * S->n - i * (i - 1) / 2 - i;
+    case STRUCTURE_BANDED:
+        *begin = (i > S->lower) ? i - S->lower : 0;
+        *end = (i + S->upper + 1 < S->n) ? i + S->upper + 1 : S->n;
+        return i * (S->lower + S->upper + 1) + S->lower - i;
+    default:
+        *begin = 0;
+        *end = i + 1;
+        return i * (i + 1) / 2;
+    }
+}
+
+double c_structured_get(const struct structured_matrix* S, int i, int j)
+{
+    if(S->kind == STRUCTURE_SYMMETRIC && j > i)
+    {
+        int t = i;
+        i = j;
+        j = t;
+    }
+
+    int begin, end;
+    int shift = c_structured_row(S, i, &begin, &end);
+    if(j < begin || j >= end)
+        return 0;
+    return S->data[shift + j];
+}
+
+// A - dense n x n matrix, elements outside of the structure are ignored
+void c_structured_from_dense(int n, const double* A, struct structured_matrix* S)
+{
+    fill_d_array(c_structured_length(S->kind, n, S->lower, S->upper), S->data, 0);
+    for(int i = 0; i < n; ++i)
+    {
+        int begin, end;
+        int shift = c_structured_row(S, i, &begin, &end);
+        copy_d_array(end - begin, A + i * n + begin, S->data + shift + begin);
+    }
+}
+
+void c_structured_to_dense(const struct structured_matrix* S, double* A)
+{
+    int n = S->n;
+    fill_d_array(n * n, A, 0);
+    for(int i = 0; i < n; ++i)
+    {
+        int begin, end;
+        int shift = c_structured_row(S, i, &begin, &end);
+        copy_d_array(end - begin, S->data + shift + begin, A + i * n + begin);
+        if(S->kind == STRUCTURE_SYMMETRIC)
+            for(int j = begin; j < i; ++j)
+                A[i + j * n] = S->data[shift + j];
+    }
+}
+
+// T has the transposed structure and allocated data
+void c_structured_transpose(const struct structured_matrix* S, struct structured_matrix* T)
+{
+    fill_d_array(c_structured_length(T->kind, T->n, T->lower, T->upper), T->data, 0);
+    for(int i = 0; i < T->n; ++i)
+    {
+        int begin, end;
+        int shift = c_structured_row(T, i, &begin, &end);
+        for(int j = begin; j < end; ++j)
+            T->data[shift + j] = c_structured_get(S, j, i);
+    }
+}
+
+// R = S * V
+void c_structured_vector_multiply(const struct structured_matrix* S, const double* V, double* R)
+{
+    for(int i = 0; i < S->n; ++i)
+    {
+        int begin, end;
+        int shift = c_structured_row(S, i, &begin, &end);
+        double sum = 0;
+        for(int j = begin; j < end; ++j)
+            sum += S->data[shift + j] * V[j];
+        R[i] = sum;
+    }
+
+    if(S->kind != STRUCTURE_SYMMETRIC)
+        return;
+    for(int i = 0; i < S->n; ++i)
+    {
+        int begin, end;
+        int shift = c_structured_row(S, i, &begin, &end);
+        for(int j = begin; j < i; ++j)
+            R[j] += S->data[shift + j] * V[i];
+    }
+}
+
+// R = S * B, B and R are dense matrices p x n
+void c_structured_dense_multiply(const struct structured_matrix* S, int p, const double* B, double* R)
+{
+    fill_d_array(p * S->n, R, 0);
+    for(int i = 0; i < S->n; ++i)
+    {
+        int begin, end;
+        int shift = c_structured_row(S, i, &begin, &end);
+        for(int j = begin; j < end; ++j)
+        {
+            double v = S->data[shift + j];
+            double* r = R + i * p;
+            const double* b = B + j * p;
+            for(int k = 0; k < p; ++k)
+                r[k] += v * b[k];
+
+            if(S->kind == STRUCTURE_SYMMETRIC && j < i)
+            {
+                r = R + j * p;
+                b = B + i * p;
+                for(int k = 0; k < p; ++k)
+                    r[k] += v * b[k];
+            }
+        }
+    }
+}
+
+// R = B * S, B and R are dense matrices n x q
+void c_dense_structured_multiply(int q, const double* B, const struct structured_matrix* S, double* R)
+{
+    int n = S->n;
+    fill_d_array(q * n, R, 0);
+    for(int r = 0; r < q; ++r)
+    {
+        const double* b = B + r * n;
+        double* res = R + r * n;
+        for(int i = 0; i < n; ++i)
+        {
+            int begin, end;
+            int shift = c_structured_row(S, i, &begin, &end);
+            for(int j = begin; j < end; ++j)
+                res[j] += b[i] * S->data[shift + j];
+            if(S->kind == STRUCTURE_SYMMETRIC)
+                for(int j = begin; j < i; ++j)
+                    res[i] += b[j] * S->data[shift + j];
+        }
+    }
+}
+
+double c_structured_determinant(const struct structured_matrix* S)
+{
+    if(S->kind == STRUCTURE_SYMMETRIC || (S->kind == STRUCTURE_BANDED && S->lower > 0 && S->upper > 0))
+    {
+        double* A = malloc(S->n * S->n * sizeof(double));
+        c_structured_to_dense(S, A);
+        double det = c_matrix_determinant(S->n, A);
+        free(A);
+        return det;
+    }
+
+    double det = 1;
+    for(int i = 0; i < S->n; ++i)
+        det *= c_structured_get(S, i, i);
+    return det;
+}
+
+// R -= v * X, rows of p elements
+void sub_scaled_row(int p, double* R, double v, const double* X)
+{
+    for(int k = 0; k < p; ++k)
+        R[k] -= v * X[k];
+}
+
+// solve a triangular or banded system which needs no pivoting,
+// the diagonal of unit_lower is not used and considered as 1
+bool c_structured_substitution(const struct structured_matrix* S, int p, double* X, bool lower, bool unit)
+{
+    int n = S->n;
+    for(int t = 0; t < n; ++t)
+    {
+        int i = lower ? t : n - 1 - t;
+        int begin, end;
+        int shift = c_structured_row(S, i, &begin, &end);
+        double* x = X + i * p;
+        if(lower)
+            for(int j = begin; j < i; ++j)
+                sub_scaled_row(p, x, S->data[shift + j], X + j * p);
+        else
+            for(int j = i + 1; j < end; ++j)
+                sub_scaled_row(p, x, S->data[shift + j], X + j * p);
+        if(unit)
+            continue;
+
+        double d = S->data[shift + i];
+        if(d == 0)
+            return false;
+        multiply_d_array(p, x, 1 / d);
+    }
+    return true;
+}
+
+// tridiagonal algorithm (Thomas), C is a buffer of n elements,
+// returns false on a zero pivot, which does not mean that S is singular
+bool c_structured_thomas(const struct structured_matrix* S, int p, double* X)
+{
+    int n = S->n;
+    double* C = malloc(n * sizeof(double));
+    double prev_c = 0;
+    for(int i = 0; i < n; ++i)
+    {
+        double a = (i > 0) ? c_structured_get(S, i, i - 1) : 0;
+        double b = c_structured_get(S, i, i);
+        double c = (i + 1 < n) ? c_structured_get(S, i, i + 1) : 0;
+        double d = b - a * prev_c;
+        if(d == 0)
+        {
+            free(C);
+            return false;
+        }
+        C[i] = c / d;
+        double* x = X + i * p;
+        if(i > 0)
+            sub_scaled_row(p, x, a, X + (i - 1) * p);
+        multiply_d_array(p, x, 1 / d);
+        prev_c = C[i];
+    }
+    for(int i = n - 2; i >= 0; --i)
+        sub_scaled_row(p, X + i * p, C[i], X + (i + 1) * p);
+    free(C);
+    return true;
+}
+
+// LU decomposition without pivoting keeps the band, L has the unit diagonal,
+// returns false on a zero pivot, which does not mean that S is singular
+bool c_structured_banded_solve(const struct structured_matrix* S, int p, double* X)
+{
+    int n = S->n;
+    int w = S->lower + S->upper + 1;
+    struct structured_matrix LU = *S;
+    LU.data = malloc(n * w * sizeof(double));
+    copy_d_array(n * w, S->data, LU.data);
+
+    for(int k = 0; k < n; ++k)
+    {
+        int k_begin, k_end;
+        int k_shift = c_structured_row(&LU, k, &k_begin, &k_end);
+        double pivot = LU.data[k_shift + k];
+        if(pivot == 0)
+        {
+            free(LU.data);
+            return false;
+        }
+        int last = (k + S->lower < n) ? k + S->lower : n - 1;
+        for(int i = k + 1; i <= last; ++i)
+        {
+            int begin, end;
+            int shift = c_structured_row(&LU, i, &begin, &end);
+            double l = LU.data[shift + k] / pivot;
+            LU.data[shift + k] = l;
+            for(int j = k + 1; j < k_end; ++j)
+                LU.data[shift + j] -= l * LU.data[k_shift + j];
+        }
+    }
+
+    c_structured_substitution(&LU, p, X, true, true);
+    bool result = c_structured_substitution(&LU, p, X, false, false);
+    free(LU.data);
+    return result;
+}
+
+// X = S^-1 * B, B and X are dense matrices p x n, returns false if S is singular
+bool c_structured_solve(const struct structured_matrix* S, int p, const double* B, double* X)
+{
+    int n = S->n;
+    switch(S->kind)
+    {
+    case STRUCTURE_DIAGONAL:
+        for(int i = 0; i < n; ++i)
+        {
+            if(S->data[i] == 0)
+                return false;
+            multiply_d_array_to_result(p, B + i * p, 1 / S->data[i], X + i * p);
+        }
+        return true;
+    case STRUCTURE_LOWER:
+    case STRUCTURE_UPPER:
+        copy_d_array(n * p, B, X);
+        return c_structured_substitution(S, p, X, S->kind == STRUCTURE_LOWER, false);
+    case STRUCTURE_BANDED:
+        copy_d_array(n * p, B, X);
+        if(S->lower == 1 && S->upper == 1 ? c_structured_thomas(S, p, X) : c_structured_banded_solve(S, p, X))
+            return true;
+        // zero pivot, the dense solver pivots rows
+        break;
+    default:
+        break;
+    }
+
+    double* A = malloc(n * n * sizeof(double));
+    c_structured_to_dense(S, A);
+    struct matrix_solver solver;
+    bool solved = c_matrix_solver_init(&solver, n, A, S->kind == STRUCTURE_SYMMETRIC ? MATRIX_SYMMETRIC : 0);
+    if(solved)
+    {
+        c_matrix_solver_apply(&solver, p, B, X);
+        c_matrix_solver_free(&solver);
+    }
+    free(A);
+    return solved;
+}
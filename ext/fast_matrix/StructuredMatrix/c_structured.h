@@ -0,0 +1,48 @@
+#ifndef FAST_MATRIX_STRUCTUREDMATRIX_C_STRUCTURED_H
+#define FAST_MATRIX_STRUCTUREDMATRIX_C_STRUCTURED_H 1
+
+#include <stdbool.h>
+
+enum structure
+{
+    STRUCTURE_DIAGONAL,
+    STRUCTURE_LOWER,
+    STRUCTURE_UPPER,
+    STRUCTURE_SYMMETRIC,
+    STRUCTURE_BANDED,
+};
+
+// square n x n matrix that stores only the elements allowed by its structure
+//  STRUCTURE_DIAGONAL  - n elements of the diagonal
+//  STRUCTURE_LOWER     - rows of the lower triangle packed one by one
+//  STRUCTURE_UPPER     - rows of the upper triangle packed one by one
+//  STRUCTURE_SYMMETRIC - the lower triangle packed as STRUCTURE_LOWER
+//  STRUCTURE_BANDED    - rows of lower + upper + 1 elements around the diagonal,
+//                        elements outside of the matrix are zero
+struct structured_matrix
+{
+    enum structure kind;
+    int n;
+    // number of diagonals below and above the main one
+    int lower;
+    int upper;
+
+    double* data;
+};
+
+int c_structured_length(enum structure kind, int n, int lower, int upper);
+int c_structured_row(const struct structured_matrix* S, int i, int* begin, int* end);
+double c_structured_get(const struct structured_matrix* S, int i, int j);
+
+void c_structured_from_dense(int n, const double* A, struct structured_matrix* S);
+void c_structured_to_dense(const struct structured_matrix* S, double* A);
+void c_structured_transpose(const struct structured_matrix* S, struct structured_matrix* T);
+
+void c_structured_vector_multiply(const struct structured_matrix* S, const double* V, double* R);
+void c_structured_dense_multiply(const struct structured_matrix* S, int p, const double* B, double* R);
+void c_dense_structured_multiply(int q, const double* B, const struct structured_matrix* S, double* R);
+
+double c_structured_determinant(const struct structured_matrix* S);
+bool c_structured_solve(const struct structured_matrix* S, int p, const double* B, double* X);
+
+#endif /* FAST_MATRIX_STRUCTUREDMATRIX_C_STRUCTURED_H */
@@ -0,0 +1,29 @@
+#ifndef FAST_MATRIX_STRUCTUREDMATRIX_HELPER_H
+#define FAST_MATRIX_STRUCTUREDMATRIX_HELPER_H 1
+
+#include "ruby.h"
+#include "StructuredMatrix/c_structured.h"
+
+inline struct structured_matrix* get_structured_from_rb_value(VALUE s)
+{
+	struct structured_matrix* data;
+	TypedData_Get_Struct(s, struct structured_matrix, &structured_type, data);
+    return data;
+}
+
+inline void c_structured_init(struct structured_matrix* S, enum structure kind, int n, int lower, int upper)
+{
+    S->kind = kind;
+    S->n = n;
+    S->lower = lower;
+    S->upper = upper;
+    S->data = malloc(c_structured_length(kind, n, lower, upper) * sizeof(double));
+}
+
+#define MAKE_STRUCTURED_AND_RB_VALUE(structured_name, rb_value_name, kind, n, lower, upper)\
+struct structured_matrix* structured_name;						\
+VALUE rb_value_name = TypedData_Make_Struct(					\
+	structured_class(kind), struct structured_matrix, &structured_type, structured_name);\
+c_structured_init(structured_name, kind, n, lower, upper)
+
+#endif /* FAST_MATRIX_STRUCTUREDMATRIX_HELPER_H */
@@ -0,0 +1,358 @@
+#include "StructuredMatrix/structured.h"
+#include "StructuredMatrix/c_structured.h"
+#include "StructuredMatrix/helper.h"
+#include "Matrix/matrix.h"
+#include "Matrix/errors.h"
+#include "Matrix/helper.h"
+#include "Vector/vector.h"
+#include "Vector/helper.h"
+#include "Helper/c_array_operations.h"
+#include "Helper/errors.h"
+
+VALUE cStructuredMatrix;
+VALUE cDiagonalMatrix;
+VALUE cTriangularMatrix;
+VALUE cSymmetricMatrix;
+VALUE cBandedMatrix;
+
+void structured_free(void* data);
+size_t structured_size(const void* data);
+
+const rb_data_type_t structured_type =
+{
+    .wrap_struct_name = "structured_matrix",
+    .function =
+    {
+        .dmark = NULL,
+        .dfree = structured_free,
+        .dsize = structured_size,
+    },
+    .data = NULL,
+    .flags = RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+void structured_free(void* data)
+{
+    free(((struct structured_matrix*)data)->data);
+    free(data);
+}
+
+size_t structured_size(const void* data)
+{
+    const struct structured_matrix* S = data;
+    if(S->data == NULL)
+        return sizeof(struct structured_matrix);
+    return sizeof(struct structured_matrix)
+        + c_structured_length(S->kind, S->n, S->lower, S->upper) * sizeof(double);
+}
+
+VALUE structured_alloc(VALUE self)
+{
+	struct structured_matrix* S = malloc(sizeof(struct structured_matrix));
+    S->kind = STRUCTURE_DIAGONAL;
+    S->n = 0;
+    S->lower = 0;
+    S->upper = 0;
+    S->data = NULL;
+	return TypedData_Wrap_Struct(self, &structured_type, S);
+}
+
+VALUE structured_class(enum structure kind)
+{
+    switch(kind)
+    {
+    case STRUCTURE_DIAGONAL:
+        return cDiagonalMatrix;
+    case STRUCTURE_LOWER:
+    case STRUCTURE_UPPER:
+        return cTriangularMatrix;
+    case STRUCTURE_SYMMETRIC:
+        return cSymmetricMatrix;
+    default:
+        return cBandedMatrix;
+    }
+}
+
+void raise_check_structured(VALUE v)
+{
+    if(RB_SPECIAL_CONST_P(v) || !RTEST(rb_obj_is_kind_of(v, cStructuredMatrix)))
+        rb_raise(fm_eTypeError, "Expected class structured matrix");
+}
+
+VALUE structured_from_dense_with(VALUE matrix, enum structure kind, int lower, int upper)
+{
+    raise_check_rbasic(matrix, cMatrix, "matrix");
+	struct matrix* A = get_matrix_from_rb_value(matrix);
+    raise_check_square_matrix(A);
+    if(lower < 0 || upper < 0 || lower >= A->n || upper >= A->n)
+        rb_raise(fm_eIndexError, "Bandwidth out of range");
+
+    MAKE_STRUCTURED_AND_RB_VALUE(S, result, kind, A->n, lower, upper);
+    c_structured_from_dense(A->n, A->data, S);
+    return result;
+}
+
+//  DiagonalMatrix.from_dense(matrix)
+VALUE structured_diagonal_from_dense(VALUE obj, VALUE matrix)
+{
+    return structured_from_dense_with(matrix, STRUCTURE_DIAGONAL, 0, 0);
+}
+
+//  TriangularMatrix.from_dense(matrix, part = :lower)
+VALUE structured_triangular_from_dense(int argc, VALUE *argv, VALUE obj)
+{
+    if(argc != 1 && argc != 2)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    if(argc == 1 || argv[1] == ID2SYM(rb_intern("lower")))
+        return structured_from_dense_with(argv[0], STRUCTURE_LOWER, 0, 0);
+    if(argv[1] == ID2SYM(rb_intern("upper")))
+        return structured_from_dense_with(argv[0], STRUCTURE_UPPER, 0, 0);
+    rb_raise(fm_eTypeError, "Expected :lower or :upper");
+    return Qnil;
+}
+
+//  SymmetricMatrix.from_dense(matrix), the lower triangle is used
+VALUE structured_symmetric_from_dense(VALUE obj, VALUE matrix)
+{
+    return structured_from_dense_with(matrix, STRUCTURE_SYMMETRIC, 0, 0);
+}
+
+//  BandedMatrix.from_dense(matrix, lower, upper)
+VALUE structured_banded_from_dense(VALUE obj, VALUE matrix, VALUE lower, VALUE upper)
+{
+    return structured_from_dense_with(matrix, STRUCTURE_BANDED,
+        raise_rb_value_to_int(lower), raise_rb_value_to_int(upper));
+}
+
+//  DiagonalMatrix.from_values(values)
+VALUE structured_diagonal_from_values(VALUE obj, VALUE values)
+{
+    values = rb_Array(values);
+    int n = RARRAY_LEN(values);
+    if(n == 0)
+        rb_raise(fm_eIndexError, "Size cannot be negative or zero");
+
+    MAKE_STRUCTURED_AND_RB_VALUE(S, result, STRUCTURE_DIAGONAL, n, 0, 0);
+    for(int i = 0; i < n; ++i)
+        S->data[i] = raise_rb_value_to_double(RARRAY_AREF(values, i));
+    return result;
+}
+
+//  BandedMatrix.tridiagonal(sub, diagonal, super)
+VALUE structured_tridiagonal(VALUE obj, VALUE sub, VALUE diagonal, VALUE super)
+{
+    sub = rb_Array(sub);
+    diagonal = rb_Array(diagonal);
+    super = rb_Array(super);
+    int n = RARRAY_LEN(diagonal);
+    if(n < 2)
+        rb_raise(fm_eIndexError, "Size must be at least 2");
+    if(RARRAY_LEN(sub) != n - 1 || RARRAY_LEN(super) != n - 1)
+        rb_raise(fm_eIndexError, "Diagonals of wrong size");
+
+    MAKE_STRUCTURED_AND_RB_VALUE(S, result, STRUCTURE_BANDED, n, 1, 1);
+    fill_d_array(3 * n, S->data, 0);
+    for(int i = 0; i < n; ++i)
+    {
+        S->data[3 * i + 1] = raise_rb_value_to_double(RARRAY_AREF(diagonal, i));
+        if(i > 0)
+            S->data[3 * i] = raise_rb_value_to_double(RARRAY_AREF(sub, i - 1));
+        if(i + 1 < n)
+            S->data[3 * i + 2] = raise_rb_value_to_double(RARRAY_AREF(super, i));
+    }
+    return result;
+}
+
+VALUE structured_size_rb(VALUE self)
+{
+    return INT2NUM(get_structured_from_rb_value(self)->n);
+}
+
+VALUE structured_structure(VALUE self)
+{
+    switch(get_structured_from_rb_value(self)->kind)
+    {
+    case STRUCTURE_DIAGONAL:
+        return ID2SYM(rb_intern("diagonal"));
+    case STRUCTURE_LOWER:
+        return ID2SYM(rb_intern("lower"));
+    case STRUCTURE_UPPER:
+        return ID2SYM(rb_intern("upper"));
+    case STRUCTURE_SYMMETRIC:
+        return ID2SYM(rb_intern("symmetric"));
+    default:
+        return ID2SYM(rb_intern("banded"));
+    }
+}
+
+//  [lower, upper] numbers of nonzero diagonals around the main one
+VALUE structured_bandwidth(VALUE self)
+{
+	struct structured_matrix* S = get_structured_from_rb_value(self);
+    switch(S->kind)
+    {
+    case STRUCTURE_LOWER:
+        return rb_assoc_new(INT2NUM(S->n - 1), INT2NUM(0));
+    case STRUCTURE_UPPER:
+        return rb_assoc_new(INT2NUM(0), INT2NUM(S->n - 1));
+    case STRUCTURE_SYMMETRIC:
+        return rb_assoc_new(INT2NUM(S->n - 1), INT2NUM(S->n - 1));
+    default:
+        return rb_assoc_new(INT2NUM(S->lower), INT2NUM(S->upper));
+    }
+}
+
+VALUE structured_get(VALUE self, VALUE row, VALUE column)
+{
+    int m = raise_rb_value_to_int(column);
+    int n = raise_rb_value_to_int(row);
+	struct structured_matrix* S = get_structured_from_rb_value(self);
+
+    m = (m < 0) ? S->n + m : m;
+    n = (n < 0) ? S->n + n : n;
+
+    if(m < 0 || n < 0 || n >= S->n || m >= S->n)
+        return Qnil;
+
+    return DBL2NUM(c_structured_get(S, n, m));
+}
+
+VALUE structured_to_matrix(VALUE self)
+{
+	struct structured_matrix* S = get_structured_from_rb_value(self);
+    MAKE_MATRIX_AND_RB_VALUE(R, result, S->n, S->n);
+    c_structured_to_dense(S, R->data);
+    return result;
+}
+
+VALUE structured_copy(VALUE self)
+{
+	struct structured_matrix* S = get_structured_from_rb_value(self);
+    MAKE_STRUCTURED_AND_RB_VALUE(R, result, S->kind, S->n, S->lower, S->upper);
+    copy_d_array(c_structured_length(S->kind, S->n, S->lower, S->upper), S->data, R->data);
+    return result;
+}
+
+VALUE structured_transpose(VALUE self)
+{
+	struct structured_matrix* S = get_structured_from_rb_value(self);
+    if(S->kind == STRUCTURE_DIAGONAL || S->kind == STRUCTURE_SYMMETRIC)
+        return structured_copy(self);
+
+    enum structure kind = S->kind;
+    if(kind == STRUCTURE_LOWER)
+        kind = STRUCTURE_UPPER;
+    else if(kind == STRUCTURE_UPPER)
+        kind = STRUCTURE_LOWER;
+    MAKE_STRUCTURED_AND_RB_VALUE(R, result, kind, S->n, S->upper, S->lower);
+    c_structured_transpose(S, R);
+    return result;
+}
+
+VALUE structured_determinant(VALUE self)
+{
+    return DBL2NUM(c_structured_determinant(get_structured_from_rb_value(self)));
+}
+
+VALUE structured_multiply(VALUE self, VALUE v)
+{
+	struct structured_matrix* S = get_structured_from_rb_value(self);
+    if(RB_FLOAT_TYPE_P(v) || FIXNUM_P(v)
+        || RB_TYPE_P(v, T_BIGNUM))
+    {
+        VALUE result = structured_copy(self);
+        struct structured_matrix* R = get_structured_from_rb_value(result);
+        multiply_d_array(c_structured_length(R->kind, R->n, R->lower, R->upper), R->data, NUM2DBL(v));
+        return result;
+    }
+    if(RB_SPECIAL_CONST_P(v))
+        rb_raise(fm_eTypeError, "Invalid klass for multiply");
+    if(RBASIC_CLASS(v) == cVector)
+    {
+        struct vector* V = get_vector_from_rb_value(v);
+        if(V->n != S->n)
+            rb_raise(fm_eIndexError, "Matrix columns differs from vector size");
+        MAKE_VECTOR_AND_RB_VALUE(R, result, S->n);
+        c_structured_vector_multiply(S, V->data, R->data);
+        return result;
+    }
+    if(rb_obj_is_kind_of(v, cStructuredMatrix))
+        v = structured_to_matrix(v);
+    if(RBASIC_CLASS(v) == cMatrix)
+    {
+        struct matrix* B = get_matrix_from_rb_value(v);
+        if(B->n != S->n)
+            rb_raise(fm_eIndexError, "First columns differs from second rows");
+        MAKE_MATRIX_AND_RB_VALUE(R, result, B->m, S->n);
+        c_structured_dense_multiply(S, B->m, B->data, R->data);
+        return result;
+    }
+    rb_raise(fm_eTypeError, "Invalid klass for multiply");
+}
+
+VALUE structured_dense_left_multiply(VALUE dense, VALUE structured)
+{
+	struct matrix* B = get_matrix_from_rb_value(dense);
+	struct structured_matrix* S = get_structured_from_rb_value(structured);
+    if(B->m != S->n)
+        rb_raise(fm_eIndexError, "First columns differs from second rows");
+    MAKE_MATRIX_AND_RB_VALUE(R, result, S->n, B->n);
+    c_dense_structured_multiply(B->n, B->data, S, R->data);
+    return result;
+}
+
+//  solve(b) for a Vector or a Matrix b
+VALUE structured_solve(VALUE self, VALUE b)
+{
+	struct structured_matrix* S = get_structured_from_rb_value(self);
+    if(!RB_SPECIAL_CONST_P(b) && RBASIC_CLASS(b) == cVector)
+    {
+        struct vector* V = get_vector_from_rb_value(b);
+        if(V->n != S->n)
+            rb_raise(fm_eIndexError, "Matrix columns differs from vector size");
+        MAKE_VECTOR_AND_RB_VALUE(X, result, S->n);
+        if(!c_structured_solve(S, 1, V->data, X->data))
+            rb_raise(fm_eIndexError, "Matrix is singular");
+        return result;
+    }
+
+    raise_check_rbasic(b, cMatrix, "matrix");
+	struct matrix* B = get_matrix_from_rb_value(b);
+    if(B->n != S->n)
+        rb_raise(fm_eIndexError, "Columns of different size");
+    MAKE_MATRIX_AND_RB_VALUE(X, result, B->m, S->n);
+    if(!c_structured_solve(S, B->m, B->data, X->data))
+        rb_raise(fm_eIndexError, "Matrix is singular");
+    return result;
+}
+
+void init_fm_structured()
+{
+    VALUE  mod = rb_define_module("FastMatrix");
+	cStructuredMatrix = rb_define_class_under(mod, "StructuredMatrix", rb_cData);
+	cDiagonalMatrix = rb_define_class_under(mod, "DiagonalMatrix", cStructuredMatrix);
+	cTriangularMatrix = rb_define_class_under(mod, "TriangularMatrix", cStructuredMatrix);
+	cSymmetricMatrix = rb_define_class_under(mod, "SymmetricMatrix", cStructuredMatrix);
+	cBandedMatrix = rb_define_class_under(mod, "BandedMatrix", cStructuredMatrix);
+	rb_define_alloc_func(cStructuredMatrix, structured_alloc);
+    rb_undef_method(CLASS_OF(cStructuredMatrix), "new");
+
+    rb_define_method(cStructuredMatrix, "row_count", structured_size_rb, 0);
+    rb_define_method(cStructuredMatrix, "column_count", structured_size_rb, 0);
+    rb_define_method(cStructuredMatrix, "structure", structured_structure, 0);
+    rb_define_method(cStructuredMatrix, "bandwidth", structured_bandwidth, 0);
+    rb_define_method(cStructuredMatrix, "[]", structured_get, 2);
+    rb_define_method(cStructuredMatrix, "to_matrix", structured_to_matrix, 0);
+    rb_define_method(cStructuredMatrix, "clone", structured_copy, 0);
+    rb_define_method(cStructuredMatrix, "transpose", structured_transpose, 0);
+    rb_define_method(cStructuredMatrix, "determinant", structured_determinant, 0);
+    rb_define_method(cStructuredMatrix, "*", structured_multiply, 1);
+    rb_define_method(cStructuredMatrix, "solve", structured_solve, 1);
+
+    rb_define_singleton_method(cDiagonalMatrix, "from_dense", structured_diagonal_from_dense, 1);
+    rb_define_singleton_method(cDiagonalMatrix, "from_values", structured_diagonal_from_values, 1);
+    rb_define_singleton_method(cTriangularMatrix, "from_dense", structured_triangular_from_dense, -1);
+    rb_define_singleton_method(cSymmetricMatrix, "from_dense", structured_symmetric_from_dense, 1);
+    rb_define_singleton_method(cBandedMatrix, "from_dense", structured_banded_from_dense, 3);
+    rb_define_singleton_method(cBandedMatrix, "tridiagonal", structured_tridiagonal, 3);
+}
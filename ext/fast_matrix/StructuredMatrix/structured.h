@@ -0,0 +1,19 @@
+#ifndef FAST_MATRIX_STRUCTUREDMATRIX_H
+#define FAST_MATRIX_STRUCTUREDMATRIX_H 1
+
+#include "ruby.h"
+#include "StructuredMatrix/c_structured.h"
+
+extern VALUE cStructuredMatrix;
+extern VALUE cDiagonalMatrix;
+extern VALUE cTriangularMatrix;
+extern VALUE cSymmetricMatrix;
+extern VALUE cBandedMatrix;
+extern const rb_data_type_t structured_type;
+
+VALUE structured_class(enum structure kind);
+//  dense * structured for Matrix#*
+VALUE structured_dense_left_multiply(VALUE dense, VALUE structured);
+void init_fm_structured();
+
+#endif /* FAST_MATRIX_STRUCTUREDMATRIX_H */
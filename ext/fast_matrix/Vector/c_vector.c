@@ -51,6 +51,16 @@ double c_vector_inner_product(int n, double* A, double* B)
 
 void c_vector_cross_product(int argc, struct vector** vcts, double* R)
 {
+    if(argc == 2)
+    {
+        const double* a = vcts[0]->data;
+        const double* b = vcts[1]->data;
+        R[0] = a[1] * b[2] - a[2] * b[1];
+        R[1] = a[2] * b[0] - a[0] * b[2];
+        R[2] = a[0] * b[1] - a[1] * b[0];
+        return;
+    }
+
     int n = argc + 1;
     double* rows = malloc(argc * n * sizeof(double));
     double* M = malloc(argc * argc * sizeof(double));
@@ -79,19 +89,12 @@ void c_vector_cross_product(int argc, struct vector** vcts, double* R)
     free(M);
 }
 
+// outer product
 // V - vector n
-// M - matrix m x 1
+// M - vector m (matrix m x 1)
 // R - matrix m x n
 void c_vector_matrix_multiply(int n, int m, const double* V, const double* M, double* R)
 {
-    fill_d_array(m * n, R, 0);
-
     for(int j = 0; j < n; ++j)
-    {
-        double* p_r = R + m * j;
-        double d_v = V[j];
-        
-        for(int i = 0; i < m; ++i)
-            p_r[i] += d_v * M[i];
-    }
+        multiply_d_array_to_result(m, M, V[j], R + m * j);
 }
\ No newline at end of file
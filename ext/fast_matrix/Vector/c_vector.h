@@ -8,6 +8,10 @@ struct vector
 {
     int n;
     double* data;
+    // owners of data, NULL if data is owned only by this one
+    struct shared_d_array* shared;
+    // number of exported memory views
+    int views;
     
     bool frozen;
 };
@@ -3,6 +3,7 @@
 
 #include "ruby.h"
 #include "Vector/c_vector.h"
+#include "Helper/c_array_operations.h"
 
 inline struct vector* get_vector_from_rb_value(VALUE m)
 {
@@ -15,6 +16,14 @@ inline void c_vector_init(struct vector* vect, int n)
 {
     vect->n = n;
     vect->data = malloc(n * sizeof(double));
+    vect->shared = NULL;
+    vect->views = 0;
+}
+
+//  copy data of the cloned vector before the first modification
+inline void c_vector_unshare(struct vector* vect)
+{
+    vect->data = unshare_d_array(vect->n, vect->data, &vect->shared);
 }
 
 #define MAKE_VECTOR_AND_RB_VALUE(vector_name, rb_value_name, n)\
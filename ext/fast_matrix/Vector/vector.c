@@ -5,11 +5,17 @@
 
 #include "Helper/c_array_operations.h"
 #include "Helper/errors.h"
+#include "Helper/memory_view.h"
+#include "Helper/serialization.h"
+#include "Helper/standard.h"
 #include "Matrix/c_matrix.h"
 #include "Matrix/helper.h"
 
 VALUE cVector;
 
+#define VECTOR_BINARY_SIGNATURE "FMV\x01"
+
+void vector_mark(void* data);
 void vector_free(void* data);
 size_t vector_size(const void* data);
 
@@ -18,7 +24,7 @@ const rb_data_type_t vector_type =
     .wrap_struct_name = "vector",
     .function =
     {
-                .dmark = NULL,
+                .dmark = vector_mark,
                 .dfree = vector_free,
                 .dsize = vector_size,
         },
@@ -26,9 +32,15 @@ const rb_data_type_t vector_type =
         .flags = RUBY_TYPED_FREE_IMMEDIATELY,
 };
 
+void vector_mark(void* data)
+{
+    mark_shared_d_array(((struct vector*)data)->shared);
+}
+
 void vector_free(void* data)
 {
-	free(((*(struct vector*)data)).data);
+    struct vector* vct = (struct vector*)data;
+    release_d_array(vct->data, vct->shared);
     free(data);
 }
 
@@ -41,6 +53,8 @@ VALUE vector_alloc(VALUE self)
 {
 	struct vector* vct = malloc(sizeof(struct vector));
     vct->data = NULL;
+    vct->shared = NULL;
+    vct->views = 0;
     vct->frozen = false;
 	return TypedData_Wrap_Struct(self, &vector_type, vct);
 }
@@ -63,6 +77,7 @@ VALUE vector_set(VALUE self, VALUE idx, VALUE v)
 {
 	struct vector* data = get_vector_from_rb_value(self);
     raise_check_frozen_vector(data);
+    c_vector_unshare(data);
     int i = raise_rb_value_to_int(idx);
     double x = raise_rb_value_to_double(v);
 
@@ -120,6 +135,7 @@ VALUE vector_add_from(VALUE self, VALUE other)
     raise_check_rbasic(other, cVector, "vector");
 	struct vector* B = get_vector_from_rb_value(other);
     raise_check_equal_size_vectors(A, B);
+    c_vector_unshare(A);
 
     int n = A->n;
 
@@ -151,8 +167,10 @@ VALUE vector_sub_from(VALUE self, VALUE other)
 {
     raise_check_rbasic(other, cVector, "vector");
 	struct vector* A = get_vector_from_rb_value(self);
+    raise_check_frozen_vector(A);
 	struct vector* B = get_vector_from_rb_value(other);
     raise_check_equal_size_vectors(A, B);
+    c_vector_unshare(A);
 
     int n = A->n;
 
@@ -179,6 +197,7 @@ VALUE vector_equal(VALUE self, VALUE other)
 	return Qfalse;
 }
 
+//  the clone shares data with the original until one of them is modified
 VALUE vector_copy(VALUE self)
 {
 	struct vector* V = get_vector_from_rb_value(self);
@@ -186,8 +205,18 @@ VALUE vector_copy(VALUE self)
     struct vector* R;
     VALUE result = TypedData_Make_Struct(cVector, struct vector, &vector_type, R);
 
-    c_vector_init(R, V->n);
-    copy_d_array(R->n, V->data, R->data);
+    //  exported data can be changed through the memory view,
+    //  writes of a writable external owner must keep reaching its memory
+    if(V->views > 0 || (!V->frozen && d_array_external(V->shared)))
+    {
+        c_vector_init(R, V->n);
+        copy_d_array(R->n, V->data, R->data);
+        return result;
+    }
+
+    R->n = V->n;
+    R->data = share_d_array(V->data, &V->shared);
+    R->shared = V->shared;
 
     return result;
 }
@@ -221,8 +250,7 @@ VALUE vector_multiply_vn(VALUE self, VALUE value)
     VALUE result = TypedData_Make_Struct(cVector, struct vector, &vector_type, R);
 
     c_vector_init(R, A->n);
-    copy_d_array(R->n, A->data, R->data);
-    multiply_d_array(R->n, R->data, d);
+    multiply_d_array_to_result(R->n, A->data, d, R->data);
 
     return result;
 }
@@ -279,6 +307,8 @@ VALUE vector_normalize(VALUE self)
 VALUE vector_normalize_self(VALUE self)
 {
 	struct vector* A = get_vector_from_rb_value(self);
+    raise_check_frozen_vector(A);
+    c_vector_unshare(A);
     c_vector_normalize_self(A->n, A->data);
     return self;
 }
@@ -374,10 +404,218 @@ VALUE vector_fill(VALUE self, VALUE value)
 	struct vector* A = get_vector_from_rb_value(self);
     raise_check_frozen_vector(A);
     double d = raise_rb_value_to_double(value);
+    c_vector_unshare(A);
     fill_d_array(A->n, A->data, d);
     return self;
 }
 
+//  the block can change the vector, so the data is read on each step
+VALUE vector_each(VALUE self)
+{
+    RETURN_ENUMERATOR(self, 0, NULL);
+	struct vector* A = get_vector_from_rb_value(self);
+    for(int i = 0; i < A->n; ++i)
+        rb_yield(DBL2NUM(A->data[i]));
+    return self;
+}
+
+VALUE vector_each_with_index(VALUE self)
+{
+    RETURN_ENUMERATOR(self, 0, NULL);
+	struct vector* A = get_vector_from_rb_value(self);
+    for(int i = 0; i < A->n; ++i)
+        rb_yield_values(2, DBL2NUM(A->data[i]), INT2NUM(i));
+    return self;
+}
+
+VALUE vector_each_with_index_self(VALUE self)
+{
+    RETURN_ENUMERATOR(self, 0, NULL);
+	struct vector* A = get_vector_from_rb_value(self);
+    raise_check_frozen_vector(A);
+
+    for(int i = 0; i < A->n; ++i)
+    {
+        double v = raise_rb_value_to_double(
+            rb_yield_values(2, DBL2NUM(A->data[i]), INT2NUM(i)));
+        raise_check_frozen_vector(A);
+        c_vector_unshare(A);
+        A->data[i] = v;
+    }
+    return self;
+}
+
+VALUE vector_to_ary(VALUE self)
+{
+	struct vector* A = get_vector_from_rb_value(self);
+    VALUE result = rb_ary_new_capa(A->n);
+    for(int i = 0; i < A->n; ++i)
+        rb_ary_push(result, DBL2NUM(A->data[i]));
+    return result;
+}
+
+VALUE vector_from_array(VALUE obj, VALUE array)
+{
+    array = rb_Array(array);
+    int n = RARRAY_LEN(array);
+    if(n == 0)
+        rb_raise(fm_eIndexError, "Size cannot be negative or zero");
+
+    MAKE_VECTOR_AND_RB_VALUE(C, result, n);
+    for(int i = 0; i < n; ++i)
+        C->data[i] = raise_rb_value_to_double(RARRAY_AREF(array, i));
+    return result;
+}
+
+//  Vector.convert, the elements of a standard vector are read directly
+VALUE vector_convert(VALUE obj, VALUE other)
+{
+    if(!RB_SPECIAL_CONST_P(other) && RBASIC_CLASS(other) == cVector)
+        return vector_copy(other);
+
+    VALUE elements = get_standard_array(other, "Vector", "@elements");
+    return vector_from_array(obj, NIL_P(elements) ? other : elements);
+}
+
+//  Vector#convert
+VALUE vector_to_standard(VALUE self)
+{
+    return rb_funcall(get_standard_class("Vector"), rb_intern("elements"), 2, vector_to_ary(self), Qfalse);
+}
+
+//  ==, the elements of a standard vector are compared without calls of []
+VALUE vector_equal_to(VALUE self, VALUE other)
+{
+    if(!RB_SPECIAL_CONST_P(other) && RBASIC_CLASS(other) == cVector)
+        return vector_equal(self, other);
+
+    struct vector* A = get_vector_from_rb_value(self);
+    VALUE elements = get_standard_array(other, "Vector", "@elements");
+    if(NIL_P(elements))
+    {
+        if(!rb_respond_to(other, rb_intern("size")) || !rb_respond_to(other, rb_intern("[]")))
+            return Qfalse;
+        if(!rb_equal(rb_funcall(other, rb_intern("size"), 0), INT2NUM(A->n)))
+            return Qfalse;
+        for(int i = 0; i < A->n; ++i)
+            if(A->data[i] != rb_value_to_f(rb_funcall(other, rb_intern("[]"), 1, INT2NUM(i))))
+                return Qfalse;
+        return Qtrue;
+    }
+
+    if(RARRAY_LEN(elements) != A->n)
+        return Qfalse;
+    for(int i = 0; i < A->n; ++i)
+        if(A->data[i] != rb_value_to_f(RARRAY_AREF(elements, i)))
+            return Qfalse;
+    return Qtrue;
+}
+
+VALUE vector_sum(int argc, VALUE *argv, VALUE self)
+{
+    enum summation method = raise_rb_value_to_summation(argc, argv);
+	struct vector* A = get_vector_from_rb_value(self);
+    return DBL2NUM(sum_d_array(A->n, A->data, method));
+}
+
+VALUE vector_mean(int argc, VALUE *argv, VALUE self)
+{
+    enum summation method = raise_rb_value_to_summation(argc, argv);
+	struct vector* A = get_vector_from_rb_value(self);
+    return DBL2NUM(sum_d_array(A->n, A->data, method) / A->n);
+}
+
+VALUE vector_min(VALUE self)
+{
+	struct vector* A = get_vector_from_rb_value(self);
+    return DBL2NUM(A->data[argmin_d_array(A->n, A->data)]);
+}
+
+VALUE vector_max(VALUE self)
+{
+	struct vector* A = get_vector_from_rb_value(self);
+    return DBL2NUM(A->data[argmax_d_array(A->n, A->data)]);
+}
+
+VALUE vector_argmin(VALUE self)
+{
+	struct vector* A = get_vector_from_rb_value(self);
+    return INT2NUM(argmin_d_array(A->n, A->data));
+}
+
+VALUE vector_argmax(VALUE self)
+{
+	struct vector* A = get_vector_from_rb_value(self);
+    return INT2NUM(argmax_d_array(A->n, A->data));
+}
+
+//  2 (by default), 1 or :inf
+VALUE vector_norm(int argc, VALUE *argv, VALUE self)
+{
+    if(argc > 1)
+        rb_raise(fm_eTypeError, "Wrong number of arguments");
+    struct vector* A = get_vector_from_rb_value(self);
+
+    if(argc == 0 || argv[0] == INT2FIX(2))
+        return DBL2NUM(c_vector_magnitude(A->n, A->data));
+    if(argv[0] == INT2FIX(1))
+        return DBL2NUM(abs_sum_d_array(A->n, A->data));
+    if(argv[0] == ID2SYM(rb_intern("inf")))
+        return DBL2NUM(abs_max_d_array(A->n, A->data));
+    rb_raise(fm_eTypeError, "Unknown norm");
+    return Qnil;
+}
+
+//  element-wise function into a new vector, self for bang methods or the out: vector
+VALUE vector_math(int argc, VALUE *argv, VALUE self, enum math_function f, bool bang)
+{
+    VALUE out = raise_get_out_option(&argc, argv);
+    double params[2];
+    raise_math_arguments(argc, argv, f, params);
+	struct vector* A = get_vector_from_rb_value(self);
+
+    if(bang)
+    {
+        if(!NIL_P(out))
+            rb_raise(fm_eTypeError, "Unknown option");
+        out = self;
+    }
+    if(NIL_P(out))
+    {
+        MAKE_VECTOR_AND_RB_VALUE(R, result, A->n);
+        math_d_array(A->n, A->data, R->data, f, params);
+        return result;
+    }
+
+    raise_check_rbasic(out, cVector, "vector");
+	struct vector* R = get_vector_from_rb_value(out);
+    raise_check_equal_size_vectors(A, R);
+    raise_check_frozen_vector(R);
+    c_vector_unshare(R);
+    math_d_array(A->n, A->data, R->data, f, params);
+    return out;
+}
+
+#define VECTOR_MATH_METHODS(name, f)                        \
+VALUE vector_##name(int argc, VALUE *argv, VALUE self)      \
+{                                                           \
+    return vector_math(argc, argv, self, f, false);         \
+}                                                           \
+VALUE vector_##name##_self(int argc, VALUE *argv, VALUE self)\
+{                                                           \
+    return vector_math(argc, argv, self, f, true);          \
+}
+
+VECTOR_MATH_METHODS(exp, MATH_EXP)
+VECTOR_MATH_METHODS(log, MATH_LOG)
+VECTOR_MATH_METHODS(sqrt, MATH_SQRT)
+VECTOR_MATH_METHODS(sin, MATH_SIN)
+VECTOR_MATH_METHODS(cos, MATH_COS)
+VECTOR_MATH_METHODS(tanh, MATH_TANH)
+VECTOR_MATH_METHODS(sigmoid, MATH_SIGMOID)
+VECTOR_MATH_METHODS(pow, MATH_POW)
+VECTOR_MATH_METHODS(clamp, MATH_CLAMP)
+
 VALUE vector_round(int argc, VALUE *argv, VALUE self)
 {
     if(argc > 1)
@@ -410,6 +648,17 @@ VALUE vector_inner_product(VALUE self, VALUE other)
     return DBL2NUM(result);
 }
 
+VALUE vector_outer_product(VALUE self, VALUE other)
+{
+    raise_check_rbasic(other, cVector, "vector");
+	struct vector* A = get_vector_from_rb_value(self);
+	struct vector* B = get_vector_from_rb_value(other);
+
+    MAKE_MATRIX_AND_RB_VALUE(R, result, B->n, A->n);
+    c_vector_matrix_multiply(A->n, B->n, A->data, B->data, R->data);
+    return result;
+}
+
 VALUE vector_angle_with(VALUE self, VALUE other)
 {
     raise_check_rbasic(other, cVector, "vector");
@@ -442,6 +691,7 @@ VALUE vector_cross_product(int argc, VALUE* argv, VALUE obj)
     c_vector_init(R, n);
 
     c_vector_cross_product(argc, vcts, R->data);
+    free(vcts);
 
     return result;
 }
@@ -519,6 +769,139 @@ VALUE vector_division(VALUE self, VALUE v)
     return result;
 }
 
+//  size and little-endian elements after a signature
+VALUE vector_to_binary(VALUE self)
+{
+	struct vector* A = get_vector_from_rb_value(self);
+    return d_array_to_binary(VECTOR_BINARY_SIGNATURE, 1, &A->n, A->data);
+}
+
+VALUE vector_from_binary(VALUE obj, VALUE str)
+{
+    int n;
+    raise_check_binary(str, VECTOR_BINARY_SIGNATURE, 1, &n);
+
+    MAKE_VECTOR_AND_RB_VALUE(R, result, n);
+    d_array_from_binary(str, 1, R->data);
+    return result;
+}
+
+//  Marshal support
+VALUE vector_dump(VALUE self, VALUE level)
+{
+    return vector_to_binary(self);
+}
+
+VALUE vector_save_npy(VALUE self, VALUE path)
+{
+	struct vector* A = get_vector_from_rb_value(self);
+    raise_save_npy(path, 1, &A->n, A->data);
+    return self;
+}
+
+VALUE vector_load_npy(VALUE obj, VALUE path)
+{
+    int ndim;
+    int shape[2];
+    bool fortran_order;
+    FILE* file = raise_open_npy(path, &ndim, shape, &fortran_order);
+
+    if(ndim != 1 && shape[0] != 1 && shape[1] != 1)
+    {
+        fclose(file);
+        rb_raise(fm_eIndexError, "Expected one-dimensional array");
+    }
+
+    MAKE_VECTOR_AND_RB_VALUE(R, result, shape[0] * shape[1]);
+    raise_read_npy(file, path, R->n, R->data);
+    return result;
+}
+
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+bool vector_memory_view_get(VALUE self, rb_memory_view_t* view, int flags)
+{
+	struct vector* V = get_vector_from_rb_value(self);
+    if((flags & RUBY_MEMORY_VIEW_WRITABLE) && V->frozen)
+        return false;
+    if(!V->frozen)
+        c_vector_unshare(V);
+
+    ++V->views;
+    return export_d_array_memory_view(view, self, V->data, 1, &V->n, V->frozen);
+}
+
+bool vector_memory_view_release(VALUE self, rb_memory_view_t* view)
+{
+	struct vector* V = get_vector_from_rb_value(self);
+    --V->views;
+    return release_d_array_memory_view(view);
+}
+
+bool vector_memory_view_available(VALUE self)
+{
+    return true;
+}
+
+const rb_memory_view_entry_t vector_memory_view_entry =
+{
+    .get_func = vector_memory_view_get,
+    .release_func = vector_memory_view_release,
+    .available_p_func = vector_memory_view_available,
+};
+
+//  copy elements from the memory view or from the packed String
+VALUE vector_from_memory_view(VALUE obj, VALUE source)
+{
+    int count;
+    if(RB_TYPE_P(source, T_STRING))
+    {
+        long len = RSTRING_LEN(source);
+        count = len / sizeof(double);
+        if(len % sizeof(double) != 0 || count == 0)
+            rb_raise(fm_eIndexError, "String is not packed doubles");
+
+        MAKE_VECTOR_AND_RB_VALUE(C, result, count);
+        memcpy(C->data, RSTRING_PTR(source), len);
+        return result;
+    }
+
+    rb_memory_view_t view;
+    raise_get_d_array_memory_view(source, &view, false, &count);
+    if(count == 0)
+    {
+        rb_memory_view_release(&view);
+        rb_raise(fm_eIndexError, "Size cannot be zero");
+    }
+
+    MAKE_VECTOR_AND_RB_VALUE(C, result, count);
+    copy_d_array_from_memory_view(count, &view, C->data);
+    rb_memory_view_release(&view);
+    return result;
+}
+
+//  vector which uses elements of the memory view without copying,
+//  the vector is frozen if the view is readonly
+VALUE vector_wrap_memory_view(VALUE obj, VALUE source)
+{
+    int count;
+    rb_memory_view_t view;
+    raise_get_d_array_memory_view(source, &view, true, &count);
+    if(count == 0)
+    {
+        rb_memory_view_release(&view);
+        rb_raise(fm_eIndexError, "Size cannot be zero");
+    }
+
+    struct vector* C;
+    VALUE result = TypedData_Make_Struct(cVector, struct vector, &vector_type, C);
+    C->n = count;
+    C->data = view.data;
+    C->frozen = view.readonly;
+    C->shared = wrap_d_array_memory_view(&view);
+    return result;
+}
+#endif /* HAVE_RUBY_MEMORY_VIEW_H */
+
 void init_fm_vector()
 {
     VALUE  mod = rb_define_module("FastMatrix");
@@ -547,7 +930,41 @@ void init_fm_vector()
 	rb_define_method(cVector, "zero?", vector_zero, 0);
 	rb_define_method(cVector, "fill!", vector_fill, 1);
 	rb_define_method(cVector, "round", vector_round, -1);
+	rb_define_method(cVector, "each", vector_each, 0);
+	rb_define_method(cVector, "each_with_index", vector_each_with_index, 0);
+	rb_define_method(cVector, "each_with_index!", vector_each_with_index_self, 0);
+	rb_define_method(cVector, "to_ary", vector_to_ary, 0);
+	rb_define_method(cVector, "sum", vector_sum, -1);
+	rb_define_method(cVector, "mean", vector_mean, -1);
+	rb_define_method(cVector, "min", vector_min, 0);
+	rb_define_method(cVector, "max", vector_max, 0);
+	rb_define_method(cVector, "argmin", vector_argmin, 0);
+	rb_define_method(cVector, "argmax", vector_argmax, 0);
+	rb_define_method(cVector, "norm", vector_norm, -1);
+	rb_define_method(cVector, "exp", vector_exp, -1);
+	rb_define_method(cVector, "exp!", vector_exp_self, -1);
+	rb_define_method(cVector, "log", vector_log, -1);
+	rb_define_method(cVector, "log!", vector_log_self, -1);
+	rb_define_method(cVector, "sqrt", vector_sqrt, -1);
+	rb_define_method(cVector, "sqrt!", vector_sqrt_self, -1);
+	rb_define_method(cVector, "sin", vector_sin, -1);
+	rb_define_method(cVector, "sin!", vector_sin_self, -1);
+	rb_define_method(cVector, "cos", vector_cos, -1);
+	rb_define_method(cVector, "cos!", vector_cos_self, -1);
+	rb_define_method(cVector, "tanh", vector_tanh, -1);
+	rb_define_method(cVector, "tanh!", vector_tanh_self, -1);
+	rb_define_method(cVector, "sigmoid", vector_sigmoid, -1);
+	rb_define_method(cVector, "sigmoid!", vector_sigmoid_self, -1);
+	rb_define_method(cVector, "pow", vector_pow, -1);
+	rb_define_method(cVector, "pow!", vector_pow_self, -1);
+	rb_define_method(cVector, "clamp", vector_clamp, -1);
+	rb_define_method(cVector, "clamp!", vector_clamp_self, -1);
+	rb_define_method(cVector, "convert", vector_to_standard, 0);
+	rb_define_method(cVector, "==", vector_equal_to, 1);
+	rb_define_singleton_method(cVector, "convert", vector_convert, 1);
+	rb_define_module_function(cVector, "from_array", vector_from_array, 1);
 	rb_define_method(cVector, "inner_product", vector_inner_product, 1);
+	rb_define_method(cVector, "outer", vector_outer_product, 1);
 	rb_define_method(cVector, "angle_with", vector_angle_with, 1);
 	rb_define_method(cVector, ">=", vector_greater_or_equal, 1);
 	rb_define_method(cVector, "<=", vector_less_or_equal, 1);
@@ -557,4 +974,15 @@ void init_fm_vector()
 	rb_define_method(cVector, "freeze", vector_freeze, 0);
 	rb_define_module_function(cVector, "independent?", vector_independent, -1);
 	rb_define_module_function(cVector, "cross_product", vector_cross_product, -1);
+	rb_define_method(cVector, "to_binary", vector_to_binary, 0);
+	rb_define_method(cVector, "_dump", vector_dump, 1);
+	rb_define_method(cVector, "save_npy", vector_save_npy, 1);
+	rb_define_module_function(cVector, "from_binary", vector_from_binary, 1);
+	rb_define_module_function(cVector, "_load", vector_from_binary, 1);
+	rb_define_module_function(cVector, "load_npy", vector_load_npy, 1);
+#ifdef HAVE_RUBY_MEMORY_VIEW_H
+	rb_define_module_function(cVector, "from_memory_view", vector_from_memory_view, 1);
+	rb_define_module_function(cVector, "wrap_memory_view", vector_wrap_memory_view, 1);
+    rb_memory_view_register(cVector, &vector_memory_view_entry);
+#endif
 }
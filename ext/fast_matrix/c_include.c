@@ -1,5 +1,9 @@
 #include "Helper/errors.c"
 #include "Helper/c_array_opeartions.c"
+#include "Helper/memory_view.c"
+#include "Helper/serialization.c"
+#include "Helper/mapped_file.c"
+#include "Helper/standard.c"
 
 #include "Matrix/matrix.c"
 #include "Matrix/c_matrix.c"
@@ -9,3 +13,20 @@
 
 #include "LUPDecomposition/lup.c"
 #include "LUPDecomposition/c_lup.c"
+
+#include "LazyMatrix/lazy.c"
+#include "LazyMatrix/c_lazy.c"
+
+#include "SparseMatrix/sparse.c"
+#include "SparseMatrix/c_sparse.c"
+
+#include "StructuredMatrix/structured.c"
+#include "StructuredMatrix/c_structured.c"
+
+#include "KroneckerMatrix/kronecker.c"
+#include "KroneckerMatrix/c_kronecker.c"
+
+#include "PointCloud/point_cloud.c"
+#include "PointCloud/c_point_cloud.c"
+
+#include "Scalar/scalar.c"
@@ -1,3 +1,6 @@
 require "mkmf"
 
+have_header("ruby/memory_view.h")
+have_header("sys/mman.h")
+
 create_makefile("fast_matrix/fast_matrix")
@@ -3,6 +3,12 @@
 #include "Matrix/matrix.h"
 #include "Vector/vector.h"
 #include "LUPDecomposition/lup.h"
+#include "LazyMatrix/lazy.h"
+#include "SparseMatrix/sparse.h"
+#include "StructuredMatrix/structured.h"
+#include "KroneckerMatrix/kronecker.h"
+#include "PointCloud/point_cloud.h"
+#include "Scalar/scalar.h"
 
 
 void Init_fast_matrix()
@@ -11,4 +17,10 @@ void Init_fast_matrix()
     init_fm_matrix();
     init_fm_vector();
     init_fm_lup();
+    init_fm_lazy();
+    init_fm_sparse();
+    init_fm_structured();
+    init_fm_kronecker();
+    init_fm_point_cloud();
+    init_fm_scalar();
 }
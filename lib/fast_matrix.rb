@@ -2,4 +2,9 @@ require 'fast_matrix/version'
 require 'vector/vector'
 require 'matrix/matrix'
 require 'lup_decomposition/lup_decomposition'
-require 'scalar'
\ No newline at end of file
+require 'lazy_matrix/lazy_matrix'
+require 'sparse_matrix/sparse_matrix'
+require 'structured_matrix/structured_matrix'
+require 'kronecker_matrix/kronecker_matrix'
+require 'point_cloud/point_cloud'
+require 'scalar'
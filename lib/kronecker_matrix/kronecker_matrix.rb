@@ -0,0 +1,32 @@
+module FastMatrix
+  #
+  # Kronecker product of two matrices that is never formed.
+  # Multiplication by a vector uses (A x B) * vec(X) = vec(A * X * B^T),
+  # so it costs products of the factors instead of the full product.
+  #
+  #   k = KroneckerMatrix.new(Matrix[[1, 2], [3, 4]], Matrix[[0, 1], [1, 0]])
+  #   k * Vector[1, 2, 3, 4]
+  #     => Vector[10, 7, 22, 15]
+  #
+  class KroneckerMatrix
+    alias row_size row_count
+    alias column_size column_count
+    alias t transpose
+
+    def to_s
+      "#{self.class}[#{row_count}x#{column_count}]"
+    end
+
+    alias inspect to_s
+  end
+
+  class Matrix
+    #
+    # Kronecker product with other that is not formed, see KroneckerMatrix.
+    # Use #kron to get the product itself.
+    #
+    def lazy_kron(other)
+      KroneckerMatrix.new(self, other)
+    end
+  end
+end
@@ -0,0 +1,122 @@
+require 'fast_matrix/fast_matrix'
+require 'errors'
+
+module FastMatrix
+  #
+  # Records element-wise operations on matrices and evaluates all of them
+  # in one pass over the elements, without intermediate matrices.
+  #
+  #   a, b, c = ...
+  #   (a.lazy * 2 + b - c.lazy.abs).to_matrix
+  #
+  class LazyMatrix
+    #
+    # Creates an expression from a program in postfix notation.
+    # Use Matrix#lazy instead.
+    #
+    def initialize(program)
+      @program = program
+    end
+
+    def +(other)
+      LazyMatrix.new(@program + operand(other) + [:+])
+    end
+
+    def -(other)
+      LazyMatrix.new(@program + operand(other) + [:-])
+    end
+
+    #
+    # Multiplication by a number
+    #
+    def *(value)
+      LazyMatrix.new(@program + [number(value), :*])
+    end
+
+    #
+    # Division by a number
+    #
+    def /(value)
+      LazyMatrix.new(@program + [number(value), :/])
+    end
+
+    def hadamard_product(other)
+      LazyMatrix.new(@program + operand(other) + [:*])
+    end
+
+    alias entrywise_product hadamard_product
+
+    def -@
+      LazyMatrix.new(@program + [:-@])
+    end
+
+    def +@
+      self
+    end
+
+    def abs
+      LazyMatrix.new(@program + [:abs])
+    end
+
+    def lazy
+      self
+    end
+
+    #
+    # Evaluates the expression
+    #
+    def to_matrix
+      LazyMatrix.evaluate(@program)
+    end
+
+    alias force to_matrix
+
+    protected
+
+    attr_reader :program
+
+    private
+
+    def operand(other)
+      case other
+      when Matrix
+        [other]
+      when LazyMatrix
+        other.program
+      else
+        raise TypeError, "Can't use #{other.class} in lazy expression"
+      end
+    end
+
+    # the extension evaluates floats, so a Rational is converted here
+    # and a Complex is rejected before the expression is evaluated
+    def number(value)
+      unless value.is_a?(Numeric) && value.real?
+        raise TypeError, "Expected real number, got #{value.class}"
+      end
+
+      value.to_f
+    end
+  end
+
+  class Matrix
+    #
+    # Returns a lazy expression for element-wise operations with this matrix.
+    # See LazyMatrix
+    #
+    def lazy
+      LazyMatrix.new([self])
+    end
+  end
+
+  #
+  # Yields lazy expressions for the given matrices and evaluates
+  # the result of the block in one pass.
+  #
+  #   FastMatrix.lazy(a, b, c) { |a, b, c| a * 2 + b - c.abs }
+  #
+  def self.lazy(*matrices)
+    result = yield(*matrices.map(&:lazy))
+    result.is_a?(LazyMatrix) ? result.to_matrix : result
+  end
+end
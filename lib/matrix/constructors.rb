@@ -6,6 +6,9 @@ module FastMatrix
   # Constructors as in the standard matrix
   #
   class Matrix
+    ##
+    # :singleton-method: build
+    # :call-seq: build(row_count, column_count = row_count) { |row, col| ... }
     #
     # Creates a matrix of size +row_count+ x +column_count+.
     # It fills the values by calling the given block,
@@ -17,12 +20,49 @@ module FastMatrix
     #   m = Matrix.build(3) { rand }
     #     => a 3x3 matrix with random elements
     #
-    def self.build(row_count, column_count = row_count, &block)
-      matrix = create_with_check(row_count, column_count)
-      raise NotImplementedError, 'Issue#17' unless block_given?
 
-      matrix.each_with_index! { |_, i, j| block.call(i, j) }
-    end
+    ##
+    # :singleton-method: column_vector
+    # :call-seq: column_vector(column)
+    #
+    # Creates a single-column matrix where the values of that column are as given
+    # in +column+.
+    #   Matrix.column_vector([4,5,6])
+    #     => 4
+    #        5
+    #        6
+    #
+
+    ##
+    # :singleton-method: row_vector
+    # :call-seq: row_vector(row)
+    #
+    # Creates a single-row matrix where the values of that row are as given in
+    # +row+.
+    #   Matrix.row_vector([4,5,6])
+    #     => 4 5 6
+    #
+
+    ##
+    # :singleton-method: diagonal
+    # :call-seq: diagonal(*values)
+    #
+    # Creates a matrix where the diagonal elements are composed of +values+.
+    #   Matrix.diagonal(9, 5, -3)
+    #     =>  9  0  0
+    #         0  5  0
+    #         0  0 -3
+    #
+
+    ##
+    # :singleton-method: identity
+    # :call-seq: identity(n)
+    #
+    # Creates an +n+ by +n+ identity matrix.
+    #   Matrix.identity(2)
+    #     => 1 0
+    #        0 1
+    #
 
     #
     # Creates a matrix where +rows+ is an array of arrays, each of which is a row
@@ -58,52 +98,6 @@ module FastMatrix
       self.rows(rows)
     end
 
-    #
-    # Creates a single-column matrix where the values of that column are as given
-    # in +column+.
-    #   Matrix.column_vector([4,5,6])
-    #     => 4
-    #        5
-    #        6
-    #
-    def self.column_vector(column)
-      matrix = create_with_check(column.size, 1)
-      column.each_with_index { |elem, i| matrix[i, 0] = elem }
-      matrix
-    end
-
-    #
-    # Creates a single-row matrix where the values of that row are as given in
-    # +row+.
-    #   Matrix.row_vector([4,5,6])
-    #     => 4 5 6
-    #
-    def self.row_vector(row)
-      matrix = create_with_check(1, row.size)
-      row.each_with_index { |elem, j| matrix[0, j] = elem }
-      matrix
-    end
-
-    #
-    # Creates a matrix where the diagonal elements are composed of +values+.
-    #   Matrix.diagonal(9, 5, -3)
-    #     =>  9  0  0
-    #         0  5  0
-    #         0  0 -3
-    #
-    def self.diagonal(*values)
-      build(values.size, values.size) { |i, j| i == j ? values[i] : 0 }
-    end
-
-    #
-    # Creates an +n+ by +n+ identity matrix.
-    #   Matrix.identity(2)
-    #     => 1 0
-    #        0 1
-    #
-    def self.identity(n)
-      scalar(n, 1)
-    end
     class << Matrix
       alias unit identity
       alias I identity
@@ -129,6 +123,29 @@ module FastMatrix
       fill(0, row_count, column_count)
     end
 
+    #
+    # Creates a matrix backed by the file with the binary form of #to_binary.
+    # Elements are loaded from the disk on demand, and the page cache is
+    # shared between processes that map the same file.
+    # +mode+ is one of:
+    #   :read  - the file is mapped read-only, the matrix is frozen;
+    #   :copy  - changes of the matrix are not written to the file;
+    #   :write - changes of the matrix are written to the file.
+    # In the :write mode a new file of +row_count+ x +column_count+ is created if needed.
+    #
+    #   File.binwrite('m.bin', Matrix[[1, 2], [3, 4]].to_binary)
+    #   Matrix.mmap('m.bin')
+    #     => 1 2
+    #        3 4
+    #
+    def self.mmap(path, row_count = nil, column_count = nil, mode: :read)
+      unless respond_to?(:mmap_file, true)
+        raise NotSupportedError, 'Memory-mapped files are not supported on this platform'
+      end
+
+      mmap_file(path.to_s, row_count, column_count, mode)
+    end
+
     #
     # Empty matrices does not supported
     #
@@ -159,6 +176,9 @@ module FastMatrix
     class << Matrix
       private
 
+      private :lines
+      private :mmap_file if method_defined?(:mmap_file)
+
       def create_with_check(row_count, column_count)
         check_dimensions(row_count, column_count)
         new(row_count, column_count)
@@ -182,22 +202,6 @@ module FastMatrix
           raise NotSupportedError, "Can't create matrix without copy elements"
         end
       end
-
-      # generalization between ::rows and ::columns
-      def lines(lines, main_is_rows)
-        sizes = [lines.size, (lines[0] || []).size]
-        offset = main_is_rows ? 0 : -1
-        matrix = create_with_check(sizes[offset], sizes[1 + offset])
-        lines.each_with_index do |second_dim, main_index|
-          raise IndexError if second_dim.size != sizes[1]
-
-          second_dim.each_with_index do |elem, second_index|
-            indices = [main_index, second_index]
-            matrix[indices[offset], indices[1 + offset]] = elem
-          end
-        end
-        matrix
-      end
     end
   end
 end
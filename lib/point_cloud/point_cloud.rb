@@ -0,0 +1,48 @@
+module FastMatrix
+  #
+  # Batch of count points of the same dimension stored by components,
+  # so the geometry kernels run along the points without a Vector per point.
+  #
+  #   cloud = PointCloud[Vector[1, 0, 0], Vector[0, 3, 4]]
+  #   cloud.magnitude
+  #     => Vector[1.0, 5.0]
+  #   cloud.cross(Vector[0, 0, 1])
+  #     => PointCloud[Vector[0, -1, 0], Vector[3, 0, 0]]
+  #
+  # The second operand of #dot, #cross and #distance is a cloud of the same size
+  # or a single Vector used for every point.
+  #
+  class PointCloud
+    include Enumerable
+
+    alias size count
+    alias norm magnitude
+    alias r magnitude
+    alias normalize_self normalize!
+
+    def each
+      return to_enum :each unless block_given?
+
+      count.times { |i| yield self[i] }
+      self
+    end
+
+    def to_a
+      map(&:to_ary)
+    end
+
+    def ==(other)
+      return false unless other.is_a?(PointCloud)
+
+      to_matrix == other.to_matrix
+    end
+
+    def to_s
+      "#{self.class}[#{map(&:to_s).join(', ')}]"
+    end
+
+    alias inspect to_s
+  end
+
+  VectorBatch = PointCloud
+end
@@ -3,42 +3,10 @@ require 'errors'
 
 module FastMatrix
 
-  class Matrix
-    #
-    # The coerce method provides support for Ruby type coercion.
-    # This coercion mechanism is used by Ruby to handle mixed-type
-    # numeric operations: it is intended to find a compatible common
-    # type between the two operands of the operator.
-    # See also Numeric#coerce.
-    #
-    def coerce(other)
-      case other
-      when Numeric
-        [Scalar.new(other), self]
-      else
-        raise TypeError, "#{self.class} can't be coerced into #{other.class}"
-      end
-    end
-  end
-
-  class Vector
-    #
-    # The coerce method provides support for Ruby type coercion.
-    # This coercion mechanism is used by Ruby to handle mixed-type
-    # numeric operations: it is intended to find a compatible common
-    # type between the two operands of the operator.
-    # See also Numeric#coerce.
-    #
-    def coerce(other)
-      case other
-      when Numeric
-        [Scalar.new(other), self]
-      else
-        raise TypeError, "#{self.class} can't be coerced into #{other.class}"
-      end
-    end
-  end
-
+  #
+  # Matrix#coerce and Vector#coerce return a Scalar as the left operand.
+  # Scalar#* and Scalar#/ with matrices and vectors are defined in C.
+  #
   class Scalar < Numeric # :nodoc:
     attr_reader :value
 
@@ -64,26 +32,6 @@ module FastMatrix
       end
     end
 
-    def *(other)
-      case other
-      when Vector, Matrix
-        other * @value
-      else
-        Scalar.new(@value * other)
-      end
-    end
-
-    def /(other)
-      case other
-      when Vector
-        raise OperationNotDefinedError, "#{@value.class}/#{other.class}"
-      when Matrix
-        self * other.inverse
-      else
-        Scalar.new(@value / other)
-      end
-    end
-
     def **(other)
       case other
       when Vector, Matrix
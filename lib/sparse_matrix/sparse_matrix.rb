@@ -0,0 +1,35 @@
+require 'fast_matrix/fast_matrix'
+
+module FastMatrix
+  #
+  # Matrix that stores only nonzero elements in the compressed sparse rows (:csr)
+  # or compressed sparse columns (:csc) format.
+  #
+  #   s = SparseMatrix.from_triplets(2, 3, [0, 1], [2, 0], [5, 7])
+  #   s.to_matrix
+  #     => 0 0 5
+  #        7 0 0
+  #   s * Vector[1, 2, 3]
+  #     => Vector[15, 7]
+  #
+  class SparseMatrix
+    alias row_size row_count
+    alias column_size column_count
+    alias t transpose
+
+    def to_s
+      "#{self.class}[#{row_count}x#{column_count}, nnz: #{nnz}, #{format}]"
+    end
+
+    alias inspect to_s
+  end
+
+  class Matrix
+    #
+    # Converts to SparseMatrix, zero elements are not stored.
+    #
+    def to_sparse(format = :csr)
+      SparseMatrix.from_dense(self, format)
+    end
+  end
+end
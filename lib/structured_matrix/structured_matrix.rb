@@ -0,0 +1,59 @@
+module FastMatrix
+  #
+  # Square matrix that stores only the elements allowed by its structure:
+  # DiagonalMatrix, TriangularMatrix (:lower or :upper), SymmetricMatrix
+  # (lower triangle is packed) and BandedMatrix (fixed lower and upper bandwidths).
+  #
+  #   t = BandedMatrix.tridiagonal([1, 1], [4, 4, 4], [1, 1])
+  #   t * Vector[1, 2, 3]
+  #     => Vector[6, 12, 14]
+  #   t.solve(Vector[6, 12, 14])
+  #     => Vector[1, 2, 3]
+  #
+  class StructuredMatrix
+    alias row_size row_count
+    alias column_size column_count
+    alias t transpose
+    alias det determinant
+
+    def square?
+      true
+    end
+
+    def ==(other)
+      return false unless other.is_a?(StructuredMatrix) || other.is_a?(Matrix)
+
+      to_matrix == (other.is_a?(StructuredMatrix) ? other.to_matrix : other)
+    end
+
+    def to_s
+      "#{self.class}[#{row_count}x#{column_count}, #{structure}, bandwidth: #{bandwidth}]"
+    end
+
+    alias inspect to_s
+  end
+
+  class DiagonalMatrix
+    def self.[](*values)
+      from_values(values)
+    end
+
+    def self.identity(n)
+      from_values(Array.new(n, 1))
+    end
+
+    def self.scalar(n, value)
+      from_values(Array.new(n, value))
+    end
+  end
+
+  class TriangularMatrix
+    def lower?
+      structure == :lower
+    end
+
+    def upper?
+      structure == :upper
+    end
+  end
+end
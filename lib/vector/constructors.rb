@@ -8,9 +8,7 @@ module FastMatrix
     #   Vector[7, 4, ...]
     #
     def self.[](*elems)
-      vector = new(elems.size)
-      vector.each_with_index! { |_, idx| elems[idx] }
-      vector
+      from_array(elems)
     end
 
     #
@@ -20,7 +18,7 @@ module FastMatrix
     #
     def self.elements(array, copy = true)
       check_flag_copy(copy)
-      self[*array]
+      from_array(array)
     end
 
     #
@@ -49,6 +47,8 @@ module FastMatrix
     class << Vector
       private
 
+      private :from_array
+
       def check_flag_copy(copy)
         unless copy
           raise NotSupportedError, "Can't create vector without copy elements"
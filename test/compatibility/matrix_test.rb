@@ -38,6 +38,29 @@ module CompatibilityTest
       assert_equal fast, FastMatrix::Matrix.convert(standard)
     end
 
+    def test_convert_from_standard_to_fast_not_square
+      standard, fast = create_matrices([1, 2, 3], [4, 5, 6])
+      assert_equal fast, FastMatrix::Matrix.convert(standard)
+    end
+
+    def test_equal_with_rational_elements
+      standard, fast = create_matrices([1, 2], [3, 4])
+      assert FastMatrix::Matrix[[0.5, 1], [1.5, 2]] == standard / 2r
+      refute fast == standard / 3r
+    end
+
+    def test_no_equal_with_different_size
+      _, fast = create_matrices([1, 2], [3, 4])
+      refute fast == ::Matrix[[1, 2]]
+      refute fast == ::Matrix[[1, 2, 0], [3, 4, 0]]
+    end
+
+    def test_no_equal_with_other_objects
+      _, fast = create_matrices([1, 2], [3, 4])
+      refute fast == nil
+      refute fast == [[1, 2], [3, 4]]
+    end
+
     def test_row_count
       standard, fast = zero_matrices(10, 20)
       assert_equal standard.row_count, fast.row_count
@@ -71,6 +71,27 @@ module CompatibilityTest
       assert_equal(Matrix[[0.5]], 1 / Matrix[[2]])
     end
 
+    def test_div_nm_float
+      assert_equal(Matrix[[-3, 1.5], [2.25, -0.75]], 1.5 / Matrix[[1, 2], [3, 4]])
+    end
+
+    def test_div_nm_singular
+      assert_raises(IndexError) { 1 / Matrix[[1, 2], [2, 4]] }
+    end
+
+    def test_multiply_float_left
+      assert_equal Vector[1, -2.5], 0.5 * Vector[2, -5]
+      assert_equal Matrix[[1.5, 3]], 1.5 * Matrix[[1, 2]]
+    end
+
+    def test_multiply_subclass
+      matrix = Class.new(Matrix)[[1, 2], [3, 4]]
+      vector = Class.new(Vector)[1, 2]
+      assert_equal Matrix[[2, 4], [6, 8]], 2 * matrix
+      assert_equal Vector[2, 4], 2 * vector
+      assert_equal Matrix[[-2, 1], [1.5, -0.5]], 1 / matrix
+    end
+
     def test_div_error
       assert_raises(OperationNotDefinedError) { 5 / Vector[1, 2] }
     end
@@ -38,6 +38,18 @@ module CompatibilityTest
       assert_equal fast, FastMatrix::Vector.convert(standard)
     end
 
+    def test_equal_with_rational_elements
+      standard, fast = create_vectors(1, 2, 3)
+      assert fast == standard / 2r * 2
+      refute fast == standard / 3r
+    end
+
+    def test_no_equal_with_different_size
+      _, fast = create_vectors(1, 2, 3)
+      refute fast == ::Vector[1, 2]
+      refute fast == :vector
+    end
+
     def test_size
       standard, fast = zero_vectors(10)
       assert_equal standard.size, fast.size
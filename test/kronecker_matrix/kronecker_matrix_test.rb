@@ -0,0 +1,77 @@
+require 'test_helper'
+
+module FastMatrixTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class KroneckerMatrixTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      @a = Matrix[[1, 2, 0], [3, 4, -1]]
+      @b = Matrix[[0, 1], [1, 0], [2, -2], [1, 1]]
+    end
+
+    def test_kron
+      m = Matrix[[1, 2], [3, 4]].kron(Matrix[[0, 5], [6, 7]])
+      expected = Matrix[[0, 5, 0, 10], [6, 7, 12, 14], [0, 15, 0, 20], [18, 21, 24, 28]]
+      assert_equal expected, m
+    end
+
+    def test_kron_sizes
+      m = @a.kron(@b)
+      assert_equal 8, m.row_count
+      assert_equal 6, m.column_count
+      assert_equal @a[1, 2] * @b[3, 0], m[7, 4]
+    end
+
+    def test_lazy_elements
+      k = @a.lazy_kron(@b)
+      m = @a.kron(@b)
+      assert_equal 8, k.row_count
+      assert_equal 6, k.column_count
+      assert_equal m, k.to_matrix
+      m.each_with_index { |v, i, j| assert_equal v, k[i, j] }
+      assert_nil k[8, 0]
+    end
+
+    def test_clone
+      k = @a.lazy_kron(@b)
+      clone = k.clone
+      assert_equal k.to_matrix, clone.to_matrix
+      clone.factors[0][0, 0] = 7
+      assert_equal @a.kron(@b), k.to_matrix
+    end
+
+    def test_multiply_vector
+      x = Vector[1, -2, 3, 0, 5, 1]
+      assert_equal @a.kron(@b) * x, @a.lazy_kron(@b) * x
+      y = Vector[1, 2, 3, 4]
+      assert_equal @b.kron(@a.transpose) * y, @b.lazy_kron(@a.transpose) * y
+    end
+
+    def test_multiply_matrix
+      x = Matrix.build(6, 3) { |i, j| i - 2 * j }
+      assert_equal @a.kron(@b) * x, @a.lazy_kron(@b) * x
+    end
+
+    def test_multiply_number
+      assert_equal @a.kron(@b) * 3, (@a.lazy_kron(@b) * 3).to_matrix
+    end
+
+    def test_transpose
+      assert_equal @a.kron(@b).transpose, @a.lazy_kron(@b).transpose.to_matrix
+    end
+
+    def test_factors_are_copied
+      a = @a.clone
+      k = a.lazy_kron(@b)
+      a[0, 0] = 100
+      assert_equal @a.kron(@b), k.to_matrix
+    end
+
+    def test_multiply_errors
+      k = @a.lazy_kron(@b)
+      assert_raises(FastMatrix::IndexError) { k * Vector[1, 2] }
+      assert_raises(FastMatrix::TypeError) { k * 'x' }
+    end
+  end
+end
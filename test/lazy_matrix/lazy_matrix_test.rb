@@ -0,0 +1,55 @@
+require 'test_helper'
+
+module FastMatrixTest
+  class LazyMatrixTest < Minitest::Test
+    include FastMatrix
+
+    def test_chain
+      a = Matrix[[1, -2], [3, 4]]
+      b = Matrix[[0, 1], [1, 0]]
+      c = Matrix[[-1, 2], [-3, 5]]
+      expected = a * 2 + b - c.abs
+      assert_equal expected, (a.lazy * 2 + b - c.lazy.abs).to_matrix
+    end
+
+    def test_block
+      a = Matrix[[1, 2], [3, 4]]
+      b = Matrix[[4, 3], [2, 1]]
+      expected = Matrix[[-1.5, -0.5], [0.5, 1.5]]
+      assert_equal expected, FastMatrix.lazy(a, b) { |x, y| (x - y) / 2 }
+    end
+
+    def test_hadamard_and_negate
+      a = Matrix[[1, 2], [3, 4]]
+      b = Matrix[[4, 3], [2, 1]]
+      expected = -a.hadamard_product(b)
+      assert_equal expected, (-a.lazy.hadamard_product(b)).to_matrix
+    end
+
+    def test_large
+      a = Matrix.build(40, 30) { |i, j| i - j }
+      b = Matrix.build(40, 30) { |i, j| i * j }
+      assert_equal (a + b) * 3, ((a.lazy + b) * 3).to_matrix
+    end
+
+    def test_different_sizes
+      a = Matrix[[1, 2], [3, 4]]
+      b = Matrix[[1, 2, 3]]
+      assert_raises(IndexError) { (a.lazy + b).to_matrix }
+    end
+
+    def test_rational
+      assert_equal Matrix[[0.5, 1]], (Matrix[[1, 2]].lazy * Rational(1, 2)).to_matrix
+      assert_equal Matrix[[3, 6]], (Matrix[[1, 2]].lazy / Rational(1, 3)).to_matrix
+    end
+
+    def test_complex
+      assert_raises(TypeError) { Matrix[[1, 2]].lazy * Complex(1, 1) }
+      assert_raises(TypeError) { Matrix[[1, 2]].lazy / Complex(1, 0) }
+    end
+
+    def test_not_number
+      assert_raises(TypeError) { Matrix[[1, 2]].lazy * Matrix[[1], [2]] }
+    end
+  end
+end
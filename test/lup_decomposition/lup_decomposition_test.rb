@@ -77,5 +77,61 @@ module FastMatrixTest
             m = lp.solve(b)
             assert_in_delta b, a * m, Matrix.new(3, 2).fill!(1e-10)
         end
+
+        def test_solve_vector
+            a = Matrix[[1, 2, 3], [4, 5, 6], [7, 8, 10]]
+            x = a.lup.solve(Vector[1, 2, 3])
+            3.times { |i| assert_in_delta i + 1, (a * x)[i], 1e-10 }
+        end
+
+        def test_update
+            a = Matrix[[1, 2, 3], [4, 5, 6], [7, 8, 10]]
+            u = Vector[1, -2, 3]
+            v = Vector[2, 0, 1]
+            lp = a.lup
+            lp.update!(u, v)
+            updated = a + u.outer(v)
+            assert_in_delta updated, lp.p.transpose * lp.l * lp.u, Matrix.new(3, 3).fill!(1e-10)
+            assert_in_delta updated.determinant, lp.det, 1e-9
+        end
+
+        def test_update_low_rank
+            a = Matrix[[1, 2, 3], [4, 5, 6], [7, 8, 10]]
+            u = Matrix[[1, 0], [0, 2], [1, 1]]
+            v = Matrix[[0, 1], [3, 0], [1, -1]]
+            lp = a.lup
+            lp.update!(u, v)
+            b = Matrix[[1], [2], [3]]
+            assert_in_delta b, (a + u * v.transpose) * lp.solve(b), Matrix.new(3, 1).fill!(1e-10)
+        end
+
+        def test_update_zero_pivot
+            a = Matrix[[2, 1], [1, 3]]
+            lp = a.lup
+            lp.update!(Vector[-2, 0], Vector[1, 0])
+            refute lp.singular?
+            assert_in_delta Matrix[[0, 1], [1, 3]], lp.p.transpose * lp.l * lp.u, Matrix.new(2, 2).fill!(1e-10)
+        end
+
+        def test_update_to_singular
+            lp = Matrix[[1, 0], [0, 1]].lup
+            lp.update!(Vector[0, -1], Vector[0, 1])
+            assert lp.singular?
+        end
+
+        def test_replace_column
+            a = Matrix[[1, 2, 3], [4, 5, 6], [7, 8, 10]]
+            lp = a.lup
+            lp.replace_column!(1, Vector[3, -1, 2])
+            c = Matrix[[1, 3, 3], [4, -1, 6], [7, 2, 10]]
+            assert_in_delta c, lp.p.transpose * lp.l * lp.u, Matrix.new(3, 3).fill!(1e-10)
+        end
+
+        def test_replace_column_errors
+            lp = Matrix[[1, 2], [3, 4]].lup
+            assert_raises(FastMatrix::IndexError) { lp.replace_column!(2, Vector[1, 2]) }
+            assert_raises(FastMatrix::IndexError) { lp.replace_column!(0, Vector[1, 2, 3]) }
+            assert_raises(FastMatrix::IndexError) { lp.update!(Vector[1, 2], Vector[1, 2, 3]) }
+        end
     end
 end
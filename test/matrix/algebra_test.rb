@@ -329,6 +329,13 @@ module FastMatrixTest
       refute m.orthogonal?
     end
 
+    def test_nan_not_orthogonal?
+      m = Matrix[[Float::NAN, 0], [0, 1]]
+      refute m.orthogonal?
+      refute m.unitary?
+      refute m.normal?
+    end
+
     def test_orthogonal_error
       m = Matrix[[1, 1, 1], [1, 1, 1]]
       assert_raises(IndexError) { m.orthogonal? }
@@ -423,6 +430,22 @@ module FastMatrixTest
       assert_equal m1, m1**1
     end
 
+    def test_exponentiation_large
+      m = Matrix[[1, 1], [1, 0]]
+      assert_equal Matrix[[1_346_269, 832_040], [832_040, 514_229]], m**30
+      assert_equal m * m**30, m**31
+    end
+
+    def test_exponentiation_neg_3
+      m = Matrix[[1, 2], [2, 3]]
+      (m**-3 * m**3).each_with_index { |v, i, j| assert_in_delta (i == j ? 1 : 0), v, 1e-9 }
+    end
+
+    def test_exponentiation_errors
+      assert_raises(IndexError) { Matrix[[1, 2], [2, 4]]**-2 }
+      assert_raises(IndexError) { Matrix[[1, 2, 4], [2, 3, 4]]**2 }
+    end
+
     def test_singular?
       m = Matrix[[1, 2, 3], [4, 5, 6], [7, 8, 9]]
       assert m.singular?
@@ -472,5 +495,185 @@ module FastMatrixTest
       m = Matrix[[1, 2], [3, 4]]
       refute m.unitary?
     end
+
+    def test_orthogonal_tolerance
+      c = Math.cos(0.3)
+      s = Math.sin(0.3)
+      m = Matrix[[c, -s, 0], [s, c, 0], [0, 0, 1 + 1e-12]]
+      refute m.orthogonal?
+      assert m.orthogonal?(1e-9)
+      assert m.unitary?(1e-9)
+      assert_raises(FastMatrix::IndexError) { m.orthogonal?(-1) }
+    end
+
+    def test_orthogonal_large
+      m = Matrix.build(40, 40) { |i, j| j == (i * 7) % 40 ? 1 : 0 }
+      assert m.orthogonal?
+      m[39, 0] = 0.5
+      refute m.orthogonal?
+    end
+
+    def test_normal_large
+      m = Matrix.build(35, 35) { |i, j| i + j }
+      assert m.normal?
+      m[20, 3] = 1
+      refute m.normal?
+      assert m.normal?(1e6)
+    end
+
+    def test_gram
+      m = Matrix.build(100, 3) { |i, j| (i * 3 + j) % 7 - 3 }
+      assert_equal m.transpose * m, m.gram
+      assert_equal m.transpose * m, m.syrk(trans: true)
+      assert_equal m * m.transpose, m.syrk
+    end
+
+    def test_syrk_large
+      m = Matrix.build(40, 70) { |i, j| (i * 5 + j * 3) % 11 - 5 }
+      assert_equal m * m.transpose, m.syrk(trans: false)
+      assert_equal m.transpose * m, m.gram
+    end
+
+    def test_gram_packed
+      m = Matrix[[1, 2], [3, 4], [5, 6]]
+      packed = m.gram(packed: true)
+      assert_instance_of SymmetricMatrix, packed
+      assert_equal m.transpose * m, packed.to_matrix
+      assert_equal m * m.transpose, m.syrk(packed: true).to_matrix
+    end
+
+    def test_syrk_unknown_option
+      assert_raises(FastMatrix::TypeError) { Matrix[[1]].syrk(transpose: true) }
+    end
+
+    def test_rank1_update
+      m = Matrix[[1, 2], [3, 4], [5, 6]]
+      m.rank1_update!(2, Vector[1, 0, -1], Vector[3, 4])
+      assert_equal Matrix[[7, 10], [3, 4], [-1, -2]], m
+    end
+
+    def test_rank1_update_errors
+      m = Matrix[[1, 2], [3, 4], [5, 6]]
+      assert_raises(FastMatrix::IndexError) { m.rank1_update!(1, Vector[3, 4], Vector[1, 0, -1]) }
+      assert_raises(FastMatrix::FrozenError) { m.freeze.rank1_update!(1, Vector[1, 0, -1], Vector[3, 4]) }
+    end
+
+    def test_rank1_update_clone
+      m = Matrix[[1, 0], [0, 1]]
+      c = m.clone
+      c.rank1_update!(1, Vector[1, 1], Vector[1, 1])
+      assert_equal Matrix[[1, 0], [0, 1]], m
+      assert_equal Matrix[[2, 1], [1, 2]], c
+    end
+
+    def test_sherman_morrison
+      a = Matrix[[4, 1, 0], [1, 3, 1], [0, 1, 2]]
+      u = Vector[1, 0, 2]
+      v = Vector[0, 1, 1]
+      b = a.inverse
+      b.sherman_morrison!(u, v)
+      assert_in_delta Matrix.identity(3), (a + u.outer(v)) * b, Matrix.new(3, 3).fill!(1e-10)
+    end
+
+    def test_sherman_morrison_singular
+      b = Matrix[[1, 0], [0, 1]]
+      assert_raises(FastMatrix::IndexError) { b.sherman_morrison!(Vector[-1, 0], Vector[1, 0]) }
+      assert_equal Matrix[[1, 0], [0, 1]], b
+    end
+
+    def test_multi_dot
+      a = Matrix.build(10, 3) { |i, j| i + j }
+      b = Matrix.build(3, 20) { |i, j| i - j }
+      c = Matrix.build(20, 2) { |i, j| (i * j) % 5 }
+      d = Matrix.build(2, 4) { |i, j| i * 2 - j }
+      assert_equal a * b * c * d, Matrix.multi_dot(a, b, c, d)
+      assert_equal a * (b * c), Matrix.multi_dot(a, b, c)
+    end
+
+    def test_multi_dot_vectors
+      a = Matrix.build(3, 4) { |i, j| i + 2 * j }
+      b = Matrix.build(4, 2) { |i, j| i - j }
+      u = Vector[1, 2, 3]
+      v = Vector[-1, 1]
+      assert_equal a * b * v, Matrix.multi_dot(a, b, v)
+      assert_equal (a * b).transpose * u, Matrix.multi_dot(u, a, b)
+      assert_equal u.inner_product(a * b * v), Matrix.multi_dot(u, a, b, v)
+    end
+
+    def test_multi_dot_single
+      a = Matrix[[1, 2], [3, 4]]
+      assert_equal a, Matrix.multi_dot(a)
+      assert_equal a * a, Matrix.multi_dot(a, a)
+    end
+
+    def test_multi_dot_errors
+      assert_raises(IndexError) { Matrix.multi_dot }
+      assert_raises(IndexError) { Matrix.multi_dot(Matrix[[1, 2]], Matrix[[1, 2]]) }
+      assert_raises(FastMatrix::TypeError) { Matrix.multi_dot(Matrix[[1]], Vector[1], Matrix[[1]]) }
+      assert_raises(FastMatrix::TypeError) { Matrix.multi_dot(1) }
+    end
+
+    def pairwise_reference(a, b)
+      row = ->(m, i) { Vector.elements((0...m.column_count).map { |t| m[i, t] }) }
+      Matrix.build(a.row_count, b.row_count) do |i, j|
+        yield row.call(a, i), row.call(b, j)
+      end
+    end
+
+    def test_pairwise_distances
+      a = Matrix.build(7, 3) { |i, j| (i * 3 + j * 5) % 7 - 3 }
+      b = Matrix.build(5, 3) { |i, j| (i + 2 * j) % 4 }
+      expected = pairwise_reference(a, b) { |u, v| (u - v).magnitude }
+      assert_in_delta expected, Matrix.pairwise_distances(a, b), Matrix.new(7, 5).fill!(1e-9)
+      squared = pairwise_reference(a, b) { |u, v| (u - v).inner_product(u - v) }
+      assert_in_delta squared, Matrix.pairwise_distances(a, b, metric: :sqeuclidean), Matrix.new(7, 5).fill!(1e-9)
+      self_distances = Matrix.pairwise_distances(a)
+      7.times { |i| assert_equal 0, self_distances[i, i] }
+    end
+
+    def test_cosine_similarity
+      a = Matrix[[1, 0], [1, 1], [0, 0], [-2, 0]]
+      expected = Matrix[[1, 2**-0.5, 0, -1], [2**-0.5, 1, 0, -(2**-0.5)], [0, 0, 0, 0], [-1, -(2**-0.5), 0, 1]]
+      delta = Matrix.new(4, 4).fill!(1e-12)
+      assert_in_delta expected, a.cosine_similarity, delta
+      assert_in_delta Matrix.build(4, 4) { |i, j| 1 - expected[i, j] }, Matrix.pairwise_distances(a, a, metric: :cosine), delta
+    end
+
+    def test_pairwise_blocks
+      a = Matrix.build(9, 2) { |i, j| i * (j + 1) }
+      b = Matrix[[0, 1], [3, 3], [-1, 2]]
+      full = Matrix.pairwise_distances(a, b)
+      firsts = []
+      Matrix.pairwise_distances(a, b, block_rows: 4) do |first, block|
+        firsts << first
+        block.each_with_index { |v, i, j| assert_equal full[first + i, j], v }
+      end
+      assert_equal [0, 4, 8], firsts
+    end
+
+    def test_pairwise_top
+      a = Matrix.build(6, 2) { |i, j| (i * 7 + j * 3) % 5 }
+      b = Matrix.build(8, 2) { |i, j| (i * 2 + j) % 6 }
+      full = Matrix.pairwise_distances(a, b)
+      indices, distances = Matrix.pairwise_distances(a, b, top: 3, block_rows: 4)
+      assert_equal 6, distances.row_count
+      assert_equal 3, distances.column_count
+      6.times do |i|
+        sorted = (0...8).map { |j| full[i, j] }.sort
+        assert_equal sorted.first(3), (0...3).map { |t| distances[i, t] }
+        indices[i].each_with_index { |j, t| assert_equal distances[i, t], full[i, j] }
+      end
+
+      similar, values = a.cosine_similarity(b, top: 20)
+      assert_equal 8, similar[0].size
+      assert values[0, 0] >= values[0, 7]
+    end
+
+    def test_pairwise_errors
+      assert_raises(FastMatrix::IndexError) { Matrix.pairwise_distances(Matrix[[1, 2]], Matrix[[1]]) }
+      assert_raises(FastMatrix::TypeError) { Matrix.pairwise_distances(Matrix[[1]], metric: :hamming) }
+      assert_raises(FastMatrix::IndexError) { Matrix.pairwise_distances(Matrix[[1]], top: 0) }
+      assert_raises(FastMatrix::TypeError) { Matrix.pairwise_distances(Matrix[[1]], top: 1) { |_| nil } }
+    end
   end
 end
@@ -55,6 +55,19 @@ module FastMatrixTest
       assert_equal expected, actual
     end
 
+    def test_build_square
+      actual = Matrix.build(2) { |row, col| row * 2 + col }
+      assert_equal Matrix[[0, 1], [2, 3]], actual
+    end
+
+    def test_build_without_block
+      assert_raises(NotImplementedError) { Matrix.build(2, 2) }
+    end
+
+    def test_build_not_number
+      assert_raises(TypeError) { Matrix.build(2, 2) { 'a' } }
+    end
+
     def test_scalar_3
       m1 = Matrix.scalar(3, 5)
       m2 = Matrix[[5, 0, 0], [0, 5, 0], [0, 0, 5]]
@@ -93,6 +106,23 @@ module FastMatrixTest
       assert_equal expected, actual
     end
 
+    def test_rows_different_size
+      assert_raises(IndexError) { Matrix.rows([[1, 2], [3]]) }
+    end
+
+    def test_columns_different_size
+      assert_raises(IndexError) { Matrix.columns([[1, 2], [3, 4, 5]]) }
+    end
+
+    def test_rows_from_vectors
+      actual = Matrix.rows([Vector[1, 2], Vector[3, 4]])
+      assert_equal Matrix[[1, 2], [3, 4]], actual
+    end
+
+    def test_rows_not_number
+      assert_raises(TypeError) { Matrix[[1, 'a']] }
+    end
+
     def test_rows_no_copy
       assert_raises(NotSupportedError) do
         Matrix.rows([[1, 2, 3]], false)
@@ -117,6 +147,15 @@ module FastMatrixTest
       assert_equal expected, actual
     end
 
+    def test_diagonal_empty
+      assert_raises(NotSupportedError) { Matrix.diagonal }
+    end
+
+    def test_identity_unit
+      assert_equal Matrix[[1, 0], [0, 1]], Matrix.unit(2)
+      assert_equal Matrix[[1, 0], [0, 1]], Matrix.I(2)
+    end
+
     def test_vstack_2
       x = Matrix[[1, 2], [3, 4]]
       y = Matrix[[5, 6], [7, 8]]
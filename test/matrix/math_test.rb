@@ -0,0 +1,121 @@
+require 'test_helper'
+
+module FastMatrixTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class MathTest < Minitest::Test
+    include FastMatrix
+
+    def assert_matrix_in_delta(expected, actual)
+      assert_equal expected.row_count, actual.row_count
+      assert_equal expected.column_count, actual.column_count
+      expected.each_with_index do |e, i, j|
+        assert_in_delta e, actual[i, j], 1e-12
+      end
+    end
+
+    def test_exp_log
+      m = Matrix[[0, 1], [2, -1]]
+      assert_matrix_in_delta Matrix[[1, Math::E], [Math::E**2, 1 / Math::E]], m.exp
+      assert_matrix_in_delta m, m.exp.log
+    end
+
+    def test_sqrt
+      assert_equal Matrix[[1, 2], [3, 4]], Matrix[[1, 4], [9, 16]].sqrt
+    end
+
+    def test_trigonometry
+      m = Matrix[[0, Math::PI / 2]]
+      assert_matrix_in_delta Matrix[[0, 1]], m.sin
+      assert_matrix_in_delta Matrix[[1, 0]], m.cos
+    end
+
+    def test_tanh_sigmoid
+      m = Matrix[[0, 1000, -1000]]
+      assert_equal Matrix[[0, 1, -1]], m.tanh
+      assert_equal Matrix[[0.5, 1, 0]], m.sigmoid
+    end
+
+    def test_pow
+      m = Matrix[[1, -2], [3, 4]]
+      assert_equal Matrix[[1, 4], [9, 16]], m.pow(2)
+      assert_equal Matrix[[1, -8], [27, 64]], m.pow(3)
+    end
+
+    def test_clamp
+      assert_equal Matrix[[0, 1], [3, 5]], Matrix[[-1, 1], [3, 7]].clamp(0, 5)
+    end
+
+    def test_wrong_arguments
+      assert_raises(TypeError) { Matrix[[1]].pow }
+      assert_raises(TypeError) { Matrix[[1]].exp(2) }
+      assert_raises(TypeError) { Matrix[[1]].exp(into: Matrix[[0]]) }
+    end
+
+    def test_bang
+      m = Matrix[[1, 4]]
+      assert_same m, m.sqrt!
+      assert_equal Matrix[[1, 2]], m
+    end
+
+    def test_bang_frozen
+      assert_raises(FrozenError) { Matrix[[1, 4]].freeze.sqrt! }
+    end
+
+    def test_bang_does_not_change_clone
+      m = Matrix[[1, 4]]
+      copy = m.clone
+      m.sqrt!
+      assert_equal Matrix[[1, 4]], copy
+    end
+
+    def test_out
+      m = Matrix[[1, 4]]
+      out = Matrix.zero(1, 2)
+      assert_same out, m.sqrt(out: out)
+      assert_equal Matrix[[1, 2]], out
+      assert_equal Matrix[[1, 4]], m
+    end
+
+    def test_out_self
+      m = Matrix[[1, 4]]
+      m.clamp(2, 3, out: m)
+      assert_equal Matrix[[2, 3]], m
+    end
+
+    def test_out_wrong_size
+      assert_raises(IndexError) { Matrix[[1, 4]].exp(out: Matrix[[1]]) }
+      assert_raises(TypeError) { Matrix[[1, 4]].exp(out: Vector[1, 2]) }
+      assert_raises(TypeError) { Matrix[[1, 4]].exp(out: 1) }
+    end
+
+    def test_expm_diagonal
+      m = Matrix[[1, 0], [0, -2]]
+      assert_matrix_in_delta Matrix[[Math::E, 0], [0, Math.exp(-2)]], m.expm
+      [0.01, 0.2, 3].each do |x|
+        assert_matrix_in_delta Matrix[[Math.exp(x), 0], [0, Math.exp(-x / 2)]], Matrix[[x, 0], [0, -x / 2]].expm
+      end
+    end
+
+    def test_expm_nilpotent
+      assert_matrix_in_delta Matrix[[1, 1], [0, 1]], Matrix[[0, 1], [0, 0]].expm
+    end
+
+    def test_expm_rotation
+      t = 0.7
+      expected = Matrix[[Math.cos(t), -Math.sin(t)], [Math.sin(t), Math.cos(t)]]
+      assert_matrix_in_delta expected, Matrix[[0, -t], [t, 0]].expm
+    end
+
+    def test_expm_scaling
+      m = Matrix[[1, 2, 0], [-3, 4, 1], [2, 0, 5]]
+      product = m.expm * (-m).expm
+      product.each_with_index { |v, i, j| assert_in_delta (i == j ? 1 : 0), v, 1e-8 }
+      diagonal = Matrix[[10, 0], [0, -7]].expm
+      assert_in_delta Math.exp(10), diagonal[0, 0], Math.exp(10) * 1e-12
+    end
+
+    def test_expm_error
+      assert_raises(IndexError) { Matrix[[1, 2]].expm }
+    end
+  end
+end
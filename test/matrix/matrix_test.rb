@@ -53,6 +53,26 @@ module FastMatrixTest
       refute_same original, clone
     end
 
+    def test_clone_modify
+      original = Matrix[[1, 2], [3, 4]]
+      clone = original.clone
+      clone[0, 0] = 5
+      original.add!(Matrix[[1, 1], [1, 1]])
+
+      assert_equal Matrix[[2, 3], [4, 5]], original
+      assert_equal Matrix[[5, 2], [3, 4]], clone
+    end
+
+    def test_clone_frozen
+      original = Matrix[[1, 2], [3, 4]]
+      original.freeze
+      clone = original.clone
+      clone.fill!(0)
+
+      assert_equal Matrix[[1, 2], [3, 4]], original
+      assert_equal Matrix.zero(2), clone
+    end
+
     def test_to_s
       m1 = Matrix[[1, 2], [3, 4]]
       assert_equal "FastMatrix::Matrix[[1.0, 2.0], [3.0, 4.0]]", m1.to_s
@@ -244,6 +264,43 @@ module FastMatrixTest
       assert_equal [1, 2, 3, 5, 6], m.each(:upper).to_a
     end
 
+    def test_each_unknown_part
+      m = Matrix[[1, 2], [3, 4]]
+      assert_raises(ArgumentError) { m.each(:middle) {} }
+    end
+
+    def test_each_with_index_part
+      m = Matrix[[1, 2], [3, 4]]
+      assert_equal [[2, 0, 1]], m.each_with_index(:strict_upper).to_a
+    end
+
+    def test_each_with_index_self
+      m = Matrix[[1, 2], [3, 4]]
+      m.each_with_index! { |e, i, j| e + i * 10 + j * 100 }
+      assert_equal Matrix[[1, 102], [13, 114]], m
+    end
+
+    def test_each_with_index_self_frozen
+      m = Matrix[[1, 2], [3, 4]].freeze
+      assert_raises(FrozenError) { m.each_with_index! { 0 } }
+    end
+
+    def test_each_with_index_self_shared
+      m = Matrix[[1, 2], [3, 4]]
+      copy = m.clone
+      m.each_with_index! { 0 }
+      assert_equal Matrix[[1, 2], [3, 4]], copy
+    end
+
+    def test_to_a
+      assert_equal [[1, 2], [3, 4], [5, 6]], Matrix[[1, 2], [3, 4], [5, 6]].to_a
+    end
+
+    def test_collect
+      m = Matrix[[1, 2], [3, 4]]
+      assert_equal [3, 7], m.collect(&:sum)
+    end
+
     def test_each_strict_upper_sq
       m = Matrix[[1, 2], [3, 4]]
       assert_equal [2], m.each(:strict_upper).to_a
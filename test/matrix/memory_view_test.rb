@@ -0,0 +1,88 @@
+require 'test_helper'
+require 'fiddle'
+
+module FastMatrixTest
+  class MatrixMemoryViewTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      skip 'Memory view is not supported' unless Matrix.respond_to?(:from_memory_view)
+    end
+
+    def test_export
+      m = Matrix[[1, 2, 3], [4, 5, 6]]
+      view = Fiddle::MemoryView.new(m)
+      assert_equal [2, 3], view.shape
+      assert_equal [24, 8], view.strides
+      assert_equal 'd', view.format
+      assert_equal 6.0, view[1, 2]
+      view.release
+    end
+
+    def test_export_frozen
+      m = Matrix[[1, 2], [3, 4]].freeze
+      view = Fiddle::MemoryView.new(m)
+      assert view.readonly?
+      view.release
+    end
+
+    def test_from_memory_view
+      m = Matrix[[1, 2, 3], [4, 5, 6]]
+      assert_equal m, Matrix.from_memory_view(m)
+      assert_equal Matrix[[1, 2], [3, 4], [5, 6]], Matrix.from_memory_view(m, 3)
+    end
+
+    def test_from_string
+      s = [1, 2, 3, 4, 5, 6].pack('d*')
+      assert_equal Matrix[[1, 2, 3], [4, 5, 6]], Matrix.from_memory_view(s, 2, 3)
+    end
+
+    def test_from_memory_view_size_error
+      m = Matrix[[1, 2, 3], [4, 5, 6]]
+      assert_raises(IndexError) { Matrix.from_memory_view(m, 4) }
+    end
+
+    def test_wrap_memory_view
+      m = Matrix[[1, 2], [3, 4]]
+      w = Matrix.wrap_memory_view(m)
+      w[0, 0] = 5
+      assert_equal Matrix[[5, 2], [3, 4]], m
+    end
+
+    def test_wrap_readonly_memory_view
+      m = Matrix[[1, 2], [3, 4]].freeze
+      w = Matrix.wrap_memory_view(m)
+      assert_raises(FrozenError) { w[0, 0] = 5 }
+    end
+
+    def test_wrap_readonly_clone
+      m = Matrix[[1, 2], [3, 4]].freeze
+      clone = Matrix.wrap_memory_view(m).clone
+      GC.start
+      clone[0, 0] = 5
+      assert_equal Matrix[[5, 2], [3, 4]], clone
+      assert_equal Matrix[[1, 2], [3, 4]], m
+    end
+
+    def test_wrap_fiddle_pointer
+      pointer = Fiddle::Pointer[[1, 2, 3, 4].pack('d*')]
+      assert_equal Matrix[[1, 2], [3, 4]], Matrix.wrap_memory_view(pointer, 2)
+    end
+
+    def test_wrap_clone
+      m = Matrix[[1, 2], [3, 4]]
+      w = Matrix.wrap_memory_view(m)
+      c = w.clone
+      w[0, 0] = 5
+      assert_equal Matrix[[5, 2], [3, 4]], m
+      assert_equal Matrix[[1, 2], [3, 4]], c
+    end
+
+    def test_wrap_after_gc
+      m = Matrix.wrap_memory_view(Fiddle::Pointer[[1, 2, 3, 4].pack('d*')], 2)
+      10.times { Matrix.wrap_memory_view(Matrix[[1, 2], [3, 4]]) }
+      GC.start
+      assert_equal Matrix[[1, 2], [3, 4]], m
+    end
+  end
+end
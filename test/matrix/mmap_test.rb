@@ -0,0 +1,122 @@
+require 'test_helper'
+require 'tmpdir'
+
+module FastMatrixTest
+  class MatrixMmapTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      skip 'Memory-mapped files are not supported' unless Matrix.respond_to?(:mmap_file, true)
+      @dir = Dir.mktmpdir
+      @path = File.join(@dir, 'm.bin')
+      File.binwrite(@path, Matrix[[1, 2, 3], [4, 5, 6]].to_binary)
+    end
+
+    def teardown
+      FileUtils.remove_entry(@dir) if @dir
+    end
+
+    def test_read
+      m = Matrix.mmap(@path)
+      assert_equal Matrix[[1, 2, 3], [4, 5, 6]], m
+      assert_raises(FrozenError) { m[0, 0] = 1 }
+    end
+
+    def test_copy
+      m = Matrix.mmap(@path, mode: :copy)
+      m[0, 0] = 7
+      assert_equal 7, m[0, 0]
+      assert_equal Matrix[[1, 2, 3], [4, 5, 6]], Matrix.mmap(@path)
+    end
+
+    def test_write
+      m = Matrix.mmap(@path, 2, 3, mode: :write)
+      m.add!(Matrix[[1, 1, 1], [1, 1, 1]])
+      assert_equal Matrix[[2, 3, 4], [5, 6, 7]], Matrix.mmap(@path)
+    end
+
+    def test_create
+      path = File.join(@dir, 'new.bin')
+      m = Matrix.mmap(path, 3, 2, mode: :write)
+      m.fill!(2)
+      m = nil
+      GC.start
+      assert_equal Matrix.fill(2, 3, 2), Matrix.from_binary(File.binread(path))
+    end
+
+    def test_clone
+      clone = Matrix.mmap(@path).clone
+      clone[1, 1] = 0
+      assert_equal Matrix[[1, 2, 3], [4, 0, 6]], clone
+    end
+
+    def test_read_clone_after_gc
+      clone = Matrix.mmap(@path).clone
+      GC.start
+      clone[0, 0] = 5
+      assert_equal Matrix[[5, 2, 3], [4, 5, 6]], clone
+      assert_equal Matrix[[1, 2, 3], [4, 5, 6]], Matrix.mmap(@path)
+    end
+
+    def test_write_clone
+      m = Matrix.mmap(@path, 2, 3, mode: :write)
+      clone = m.clone
+      m[1, 1] = 9
+      clone[0, 0] = 0
+      assert_equal Matrix[[1, 2, 3], [4, 9, 6]], Matrix.mmap(@path)
+      assert_equal Matrix[[0, 2, 3], [4, 5, 6]], clone
+    end
+
+    def test_sizes_differ
+      assert_raises(IndexError) { Matrix.mmap(@path, 3, 2) }
+    end
+
+    def test_invalid_file
+      File.write(@path, 'not a matrix')
+      assert_raises(TypeError) { Matrix.mmap(@path) }
+    end
+
+    def test_invalid_mode
+      assert_raises(TypeError) { Matrix.mmap(@path, mode: :append) }
+    end
+
+    def test_freeze_shared
+      m = Matrix[[1, 2], [3, 4]]
+      m.freeze_shared
+      assert m.shared_memory?
+      assert_equal Matrix[[1, 2], [3, 4]], m
+      assert_raises(FrozenError) { m[0, 0] = 1 }
+    end
+
+    def test_freeze_shared_fork
+      skip 'fork is not supported' unless Process.respond_to?(:fork)
+      m = Matrix.build(3, 3) { |i, j| i * 3 + j }.freeze_shared
+      reader, writer = IO.pipe
+      pid = fork do
+        reader.close
+        writer.write(m.to_binary)
+        writer.close
+        exit!(0)
+      end
+      writer.close
+      assert_equal m, Matrix.from_binary(reader.read)
+      Process.wait(pid)
+    end
+
+    def test_freeze_shared_clone
+      m = Matrix[[1, 2], [3, 4]]
+      clone = m.clone
+      m.freeze_shared
+      clone[0, 0] = 0
+      assert_equal Matrix[[0, 2], [3, 4]], clone
+      assert_equal Matrix[[1, 2], [3, 4]], m
+    end
+
+    def test_clone_of_freeze_shared_after_gc
+      clone = Matrix[[1, 2], [3, 4]].freeze_shared.clone
+      GC.start
+      clone[0, 0] = 5
+      assert_equal Matrix[[5, 2], [3, 4]], clone
+    end
+  end
+end
@@ -0,0 +1,92 @@
+require 'test_helper'
+
+module FastMatrixTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class ReductionsTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      @m = Matrix[[1, -7, 3], [4, 5, -6]]
+    end
+
+    def test_sum
+      assert_equal 0, @m.sum
+      assert_equal 0, @m.sum(:kahan)
+    end
+
+    def test_sum_unknown_method
+      assert_raises(TypeError) { @m.sum(:naive) }
+    end
+
+    def test_sum_kahan_compensated
+      m = Matrix.build(1, 1001) { |_, j| j.zero? ? 1e16 : 1 }
+      assert_equal 1e16 + 1000, m.sum(:kahan)
+    end
+
+    def test_sum_pairwise_large
+      m = Matrix.build(300, 301) { |i, j| i - j }
+      assert_equal(-150 * 300 * 301 + 149.5 * 300 * 301, m.sum)
+    end
+
+    def test_mean
+      assert_equal 3, Matrix[[1, 2], [3, 6]].mean
+    end
+
+    def test_min_max
+      assert_equal(-7, @m.min)
+      assert_equal 5, @m.max
+    end
+
+    def test_argmin_argmax
+      assert_equal [0, 1], @m.argmin
+      assert_equal [1, 1], @m.argmax
+    end
+
+    def test_norm_fro
+      assert_in_delta Math.sqrt(136), @m.norm
+      assert_in_delta Math.sqrt(136), @m.norm(:fro)
+    end
+
+    def test_norm_1
+      assert_equal 12, @m.norm(1)
+    end
+
+    def test_norm_inf
+      assert_equal 15, @m.norm(:inf)
+    end
+
+    def test_norm_unknown
+      assert_raises(TypeError) { @m.norm(3) }
+    end
+
+    def test_row_sums
+      assert_equal Vector[-3, 3], @m.row_sums
+      assert_equal Vector[-3, 3], @m.row_sums(:kahan)
+    end
+
+    def test_column_sums
+      assert_equal Vector[5, -2, -3], @m.column_sums
+      assert_equal Vector[5, -2, -3], @m.column_sums(:kahan)
+    end
+
+    def test_column_sums_many_rows
+      m = Matrix.build(37, 2) { |i, j| i * (j + 1) }
+      assert_equal Vector[666, 1332], m.column_sums
+    end
+
+    def test_row_column_means
+      assert_equal Vector[-1, 1], @m.row_means
+      assert_equal Vector[2.5, -1, -1.5], @m.column_means
+    end
+
+    def test_row_min_max
+      assert_equal Vector[3, 5], @m.row_max
+      assert_equal Vector[-7, -6], @m.row_min
+    end
+
+    def test_column_min_max
+      assert_equal Vector[4, 5, 3], @m.column_max
+      assert_equal Vector[1, -7, -6], @m.column_min
+    end
+  end
+end
@@ -0,0 +1,90 @@
+require 'test_helper'
+require 'tmpdir'
+
+module FastMatrixTest
+  class MatrixSerializationTest < Minitest::Test
+    include FastMatrix
+
+    def test_binary
+      m = Matrix[[1, 2.5, 3], [-4, 5, 6]]
+      assert_equal m, Matrix.from_binary(m.to_binary)
+    end
+
+    def test_binary_size
+      m = Matrix[[1, 2, 3], [4, 5, 6]]
+      assert_equal 16 + 6 * 8, m.to_binary.bytesize
+    end
+
+    def test_old_binary_version
+      old = "FMM\x01".b + [1, 1].pack('l<l<') + [1].pack('E')
+      assert_raises(TypeError) { Matrix.from_binary(old) }
+    end
+
+    def test_invalid_binary
+      assert_raises(TypeError) { Matrix.from_binary('not a matrix') }
+      assert_raises(TypeError) { Matrix.from_binary(Vector[1, 2].to_binary) }
+    end
+
+    def test_marshal
+      m = Matrix[[1, 2], [3, 4], [5, 6]]
+      assert_equal m, Marshal.load(Marshal.dump(m))
+    end
+
+    def test_npy
+      m = Matrix[[1, 2, 3], [4, 5, 6]]
+      Dir.mktmpdir do |dir|
+        path = File.join(dir, 'm.npy')
+        m.save_npy(path)
+        assert_equal 0, File.size(path) % 8
+        assert_equal m, Matrix.load_npy(path)
+      end
+    end
+
+    def test_npy_fortran_order
+      header = "{'descr': '<f8', 'fortran_order': True, 'shape': (2, 3), }"
+      header += ' ' * (63 - (10 + header.size) % 64) + "\n"
+      data = "\x93NUMPY\x01\x00".b + [header.size].pack('v') + header + [1, 4, 2, 5, 3, 6].pack('E*')
+      Dir.mktmpdir do |dir|
+        path = File.join(dir, 'm.npy')
+        File.binwrite(path, data)
+        assert_equal Matrix[[1, 2, 3], [4, 5, 6]], Matrix.load_npy(path)
+      end
+    end
+
+    def test_invalid_npy
+      Dir.mktmpdir do |dir|
+        path = File.join(dir, 'm.npy')
+        File.write(path, 'not a npy file')
+        assert_raises(TypeError) { Matrix.load_npy(path) }
+      end
+    end
+
+    def npy_data(shape, order, values)
+      header = "{'descr': '<f8', 'fortran_order': #{order}, 'shape': #{shape}, }"
+      header += ' ' * (63 - (10 + header.size) % 64) + "\n"
+      "\x93NUMPY\x01\x00".b + [header.size].pack('v') + header + values.pack('E*')
+    end
+
+    def test_npy_too_big
+      Dir.mktmpdir do |dir|
+        path = File.join(dir, 'm.npy')
+        File.binwrite(path, npy_data('(65536, 65537)', 'False', [0] * 65536))
+        assert_raises(TypeError) { Matrix.load_npy(path) }
+      end
+    end
+
+    def test_npy_fortran_order_truncated
+      Dir.mktmpdir do |dir|
+        path = File.join(dir, 'm.npy')
+        File.binwrite(path, npy_data('(2, 3)', 'True', [1, 2]))
+        assert_raises(TypeError) { Matrix.load_npy(path) }
+      end
+    end
+
+    def test_binary_too_big
+      signature = Matrix[[1]].to_binary[0, 4]
+      data = signature + [65536, 65537, 0].pack('l<l<l<') + [0].pack('E') * 1024
+      assert_raises(TypeError) { Matrix.from_binary(data) }
+    end
+  end
+end
@@ -0,0 +1,117 @@
+# frozen_string_literal: true
+require 'test_helper'
+
+module FastMatrixTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class StructureTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      @dense = Matrix[[2, 1, 3], [4, -1, 5], [1, 2, 7]]
+      @diagonal = Matrix[[2, 0, 0], [0, -4, 0], [0, 0, 5]]
+      @lower = Matrix[[2, 0, 0], [3, -1, 0], [1, 4, 5]]
+      @upper = Matrix[[2, 3, 1], [0, -1, 4], [0, 0, 5]]
+      @permutation = Matrix[[0, 1, 0], [0, 0, 1], [1, 0, 0]]
+      @structured = [@diagonal, @lower, @upper, @permutation]
+    end
+
+    def assert_near(expected, actual)
+      expected.each_with_index { |v, i, j| assert_in_delta v, actual[i, j], 1e-9 }
+    end
+
+    def test_multiply_structured_left
+      @structured.each { |s| assert_equal s.to_a, (s * Matrix.identity(3)).to_a }
+      @structured.each do |s|
+        expected = Matrix.build(3, 3) { |i, j| (0..2).sum { |k| s[i, k] * @dense[k, j] } }
+        assert_equal expected, s * @dense
+      end
+    end
+
+    def test_multiply_structured_right
+      other = Matrix[[1, 2, 3], [4, 5, 6]]
+      @structured.each do |s|
+        expected = Matrix.build(2, 3) { |i, j| (0..2).sum { |k| other[i, k] * s[k, j] } }
+        assert_equal expected, other * s
+      end
+    end
+
+    def test_multiply_vector
+      v = Vector[1, -2, 3]
+      @structured.each do |s|
+        expected = Vector.elements((0..2).map { |i| (0..2).sum { |k| s[i, k] * v[k] } })
+        assert_equal expected, s * v
+      end
+    end
+
+    def test_determinant
+      assert_equal(-40, @diagonal.determinant)
+      assert_equal(-10, @lower.determinant)
+      assert_equal(-10, @upper.determinant)
+      assert_equal 1, @permutation.determinant
+      assert_equal(-1, Matrix[[0, 1], [1, 0]].determinant)
+    end
+
+    def test_inverse
+      (@structured + [@dense]).each { |s| assert_near Matrix.identity(3), s * s.inverse }
+    end
+
+    def test_inverse_singular
+      assert_raises(FastMatrix::IndexError) { Matrix[[1, 0], [0, 0]].inverse }
+      assert_raises(FastMatrix::IndexError) { Matrix[[1, 0], [2, 0]].inverse }
+    end
+
+    def test_solve_vector
+      x = Vector[1, -2, 3]
+      (@structured + [@dense]).each do |s|
+        solution = s.solve(s * x)
+        3.times { |i| assert_in_delta x[i], solution[i], 1e-9 }
+      end
+    end
+
+    def test_solve_matrix
+      x = Matrix[[1, 2], [-3, 4], [5, 0]]
+      (@structured + [@dense]).each { |s| assert_near x, s.solve(s * x) }
+    end
+
+    def test_solve_symmetric
+      spd = Matrix[[4, 1, 2], [1, 5, 1], [2, 1, 6]]
+      indefinite = Matrix[[1, 2, 0], [2, 1, 3], [0, 3, 1]]
+      x = Matrix[[1, 2], [-3, 4], [5, 0]]
+      [spd, indefinite].each { |s| assert_near x, s.solve(s * x) }
+    end
+
+    def test_solve_refine
+      hilbert = Matrix.build(8, 8) { |i, j| 1.0 / (i + j + 1) }
+      x = Vector.elements((1..8).to_a)
+      b = hilbert * x
+      plain = hilbert.solve(b)
+      refined = hilbert.solve(b, refine: true)
+      assert (refined - x).magnitude <= (plain - x).magnitude
+      (@structured + [@dense]).each { |s| assert_near Matrix[[1], [-2], [3]], s.solve(s * Matrix[[1], [-2], [3]], refine: true) }
+    end
+
+    def test_solve_singular
+      assert_raises(FastMatrix::IndexError) { Matrix[[1, 2], [2, 4]].solve(Vector[1, 1]) }
+      assert_raises(FastMatrix::IndexError) { Matrix[[1, 0], [0, 0]].solve(Vector[1, 1]) }
+    end
+
+    def test_solve_errors
+      assert_raises(FastMatrix::IndexError) { @dense.solve(Vector[1, 2]) }
+      assert_raises(FastMatrix::IndexError) { Matrix[[1, 2]].solve(Vector[1]) }
+      assert_raises(FastMatrix::TypeError) { @dense.solve(Vector[1, 2, 3], exact: true) }
+      assert_raises(FastMatrix::TypeError) { @dense.solve }
+    end
+
+    def test_structure_changes_after_modification
+      m = @diagonal.clone
+      assert m.diagonal?
+      m[0, 1] = 1
+      refute m.diagonal?
+      assert m.upper_triangular?
+      assert_equal m.to_a, (m * Matrix.identity(3)).to_a
+      m.fill!(1)
+      refute m.upper_triangular?
+      assert m.symmetric?
+    end
+  end
+end
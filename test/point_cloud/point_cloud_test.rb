@@ -0,0 +1,103 @@
+require 'test_helper'
+
+module FastMatrixTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class PointCloudTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      @points = [Vector[1, 2, 3], Vector[-1, 0, 4], Vector[0, 3, -4], Vector[2, 2, 1]]
+      @others = [Vector[0, 1, 0], Vector[2, 1, 1], Vector[5, -1, 0], Vector[1, 1, 1]]
+      @cloud = PointCloud[*@points]
+      @other = PointCloud[*@others]
+    end
+
+    def test_create
+      assert_equal 4, @cloud.count
+      assert_equal 3, @cloud.dim
+      assert_equal @points[2], @cloud[2]
+      assert_equal @points[3], @cloud[-1]
+      assert_nil @cloud[4]
+      assert_equal @points, @cloud.to_a.map { |a| Vector[*a] }
+    end
+
+    def test_new
+      cloud = PointCloud.new(2, 3)
+      assert_equal Vector[0, 0, 0], cloud[1]
+      cloud[1] = Vector[1, 2, 3]
+      assert_equal Vector[1, 2, 3], cloud[1]
+      assert_raises(FastMatrix::IndexError) { cloud[2] = Vector[1, 2, 3] }
+      assert_raises(FastMatrix::IndexError) { cloud[0] = Vector[1, 2] }
+    end
+
+    def test_clone
+      clone = @cloud.clone
+      assert_equal 4, clone.count
+      assert_equal 3, clone.dim
+      clone[0] = Vector[0, 0, 0]
+      assert_equal @points, @cloud.to_a.map { |a| Vector[*a] }
+      assert_equal Vector[0, 0, 0], clone[0]
+      assert_equal @points[1], clone[1]
+    end
+
+    def test_matrix
+      m = Matrix.rows(@points.map(&:to_ary))
+      assert_equal m, @cloud.to_matrix
+      assert_equal @cloud, PointCloud.from_matrix(m)
+    end
+
+    def test_dot
+      expected = Vector.elements(@points.zip(@others).map { |a, b| a.inner_product(b) })
+      assert_equal expected, @cloud.dot(@other)
+      assert_equal Vector.elements(@points.map { |a| a[1] }), @cloud.dot(Vector[0, 1, 0])
+    end
+
+    def test_cross
+      cross = @cloud.cross(@other)
+      @points.zip(@others).each_with_index do |(a, b), i|
+        assert_equal Vector.cross_product(a, b), cross[i]
+      end
+      z = Vector[0, 0, 1]
+      @points.each_with_index { |a, i| assert_equal Vector.cross_product(a, z), @cloud.cross(z)[i] }
+    end
+
+    def test_magnitude_and_normalize
+      magnitude = @cloud.magnitude
+      normalized = @cloud.normalize
+      @points.each_with_index do |a, i|
+        assert_in_delta a.magnitude, magnitude[i], 1e-12
+        assert_in_delta 1, normalized[i].magnitude, 1e-12
+      end
+      zero = PointCloud.new(1, 2).normalize!
+      assert_equal Vector[0, 0], zero[0]
+    end
+
+    def test_distance
+      distance = @cloud.distance(@other)
+      @points.zip(@others).each_with_index do |(a, b), i|
+        assert_in_delta (a - b).magnitude, distance[i], 1e-12
+      end
+      assert_in_delta 4, @cloud.distance(Vector[0, 3, 0])[2], 1e-12
+    end
+
+    def test_apply
+      m = Matrix[[0, -1, 0], [1, 0, 0]]
+      moved = @cloud.apply(m)
+      assert_equal 2, moved.dim
+      @points.each_with_index { |a, i| assert_equal m * a, moved[i] }
+    end
+
+    def test_errors
+      assert_raises(FastMatrix::IndexError) { @cloud.dot(PointCloud.new(3, 3)) }
+      assert_raises(FastMatrix::IndexError) { @cloud.distance(Vector[1, 2]) }
+      assert_raises(FastMatrix::IndexError) { PointCloud.new(2, 2).cross(Vector[1, 2]) }
+      assert_raises(FastMatrix::IndexError) { @cloud.apply(Matrix[[1, 2]]) }
+      assert_raises(FastMatrix::IndexError) { PointCloud[Vector[1, 2], Vector[1]] }
+      assert_raises(FastMatrix::TypeError) { @cloud.dot(Matrix[[1]]) }
+    end
+
+    def test_vector_batch
+      assert_same PointCloud, VectorBatch
+    end
+  end
+end
@@ -0,0 +1,130 @@
+require 'test_helper'
+
+module FastMatrixTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class SparseMatrixTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      @dense = Matrix[[0, 0, 5, 0], [7, 0, 0, 1], [0, 0, 0, 0]]
+    end
+
+    def test_from_triplets
+      s = SparseMatrix.from_triplets(3, 4, [1, 0, 1], [3, 2, 0], [1, 5, 7])
+      assert_equal 3, s.row_count
+      assert_equal 4, s.column_count
+      assert_equal 3, s.nnz
+      assert_equal @dense, s.to_matrix
+    end
+
+    def test_from_triplets_csc
+      s = SparseMatrix.from_triplets(3, 4, [1, 0, 1], [3, 2, 0], [1, 5, 7], :csc)
+      assert_equal :csc, s.format
+      assert_equal @dense, s.to_matrix
+    end
+
+    def test_from_triplets_duplicates
+      s = SparseMatrix.from_triplets(2, 2, [0, 1, 0], [1, 0, 1], [2, 3, 4])
+      assert_equal 2, s.nnz
+      assert_equal Matrix[[0, 6], [3, 0]], s.to_matrix
+    end
+
+    def test_from_triplets_errors
+      assert_raises(IndexError) { SparseMatrix.from_triplets(2, 2, [2], [0], [1]) }
+      assert_raises(IndexError) { SparseMatrix.from_triplets(2, 2, [0, 1], [0], [1]) }
+      assert_raises(IndexError) { SparseMatrix.from_triplets(0, 2, [], [], []) }
+      assert_raises(TypeError) { SparseMatrix.from_triplets(2, 2, [0], [0], ['a']) }
+      assert_raises(TypeError) { SparseMatrix.from_triplets(2, 2, [0], [0], [1], :coo) }
+    end
+
+    def test_from_triplets_empty
+      s = SparseMatrix.from_triplets(2, 3, [], [], [])
+      assert_equal 0, s.nnz
+      assert_equal Matrix.zero(2, 3), s.to_matrix
+    end
+
+    def test_from_dense
+      s = @dense.to_sparse
+      assert_equal 3, s.nnz
+      assert_equal :csr, s.format
+      assert_equal @dense, s.to_matrix
+      assert_equal @dense, @dense.to_sparse(:csc).to_matrix
+    end
+
+    def test_get
+      s = @dense.to_sparse
+      assert_equal 7, s[1, 0]
+      assert_equal 0, s[1, 1]
+      assert_equal 1, s[-2, -1]
+      assert_nil s[3, 0]
+      assert_equal 5, @dense.to_sparse(:csc)[0, 2]
+    end
+
+    def test_to_triplets
+      s = @dense.to_sparse
+      assert_equal [[0, 1, 1], [2, 0, 3], [5, 7, 1]], s.to_triplets
+    end
+
+    def test_transpose
+      assert_equal @dense.transpose, @dense.to_sparse.transpose.to_matrix
+      assert_equal @dense.transpose, @dense.to_sparse(:csc).t.to_matrix
+    end
+
+    def test_format_conversion
+      s = @dense.to_sparse
+      assert_equal :csc, s.to_csc.format
+      assert_equal @dense, s.to_csc.to_matrix
+      assert_equal @dense, s.to_csc.to_csr.to_matrix
+      assert_equal [[0, 1, 1], [2, 0, 3], [5, 7, 1]], s.to_csc.to_csr.to_triplets
+    end
+
+    def test_multiply_vector
+      v = Vector[1, 2, 3, 4]
+      assert_equal @dense * v, @dense.to_sparse * v
+      assert_equal @dense * v, @dense.to_sparse(:csc) * v
+    end
+
+    def test_multiply_vector_wrong_size
+      assert_raises(IndexError) { @dense.to_sparse * Vector[1, 2] }
+    end
+
+    def test_multiply_matrix
+      m = Matrix[[1, 2], [3, 4], [5, 6], [7, 8]]
+      assert_equal @dense * m, @dense.to_sparse * m
+      assert_equal @dense * m, @dense.to_sparse(:csc) * m
+    end
+
+    def test_multiply_number
+      assert_equal @dense * 2, (@dense.to_sparse * 2).to_matrix
+    end
+
+    def test_multiply_error
+      assert_raises(TypeError) { @dense.to_sparse * 'a' }
+      assert_raises(TypeError) { @dense.to_sparse * nil }
+    end
+
+    def test_to_vector
+      s = SparseMatrix.from_triplets(3, 1, [2], [0], [4])
+      assert_equal Vector[0, 0, 4], s.to_vector
+      assert_raises(IndexError) { @dense.to_sparse.to_vector }
+    end
+
+    def test_clone
+      s = @dense.to_sparse
+      assert_equal @dense, s.clone.to_matrix
+    end
+
+    def test_uninitialized
+      s = SparseMatrix.new
+      assert_raises(FastMatrix::TypeError) { s.transpose }
+      assert_raises(FastMatrix::TypeError) { s.clone }
+      assert_raises(FastMatrix::TypeError) { s.nnz }
+    end
+
+    def test_empty_triplets
+      s = SparseMatrix.from_triplets(2, 3, [], [], [])
+      assert_equal 0, s.nnz
+      assert_equal Matrix.new(2, 3).fill!(0), s.to_matrix
+    end
+  end
+end
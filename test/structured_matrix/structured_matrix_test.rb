@@ -0,0 +1,102 @@
+require 'test_helper'
+
+module FastMatrixTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class StructuredMatrixTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      @dense = Matrix[[4, 1, 0, 0], [2, 5, 1, 0], [0, 3, 6, 2], [0, 0, 1, 7]]
+      @vector = Vector[1, -2, 3, 4]
+    end
+
+    def test_diagonal
+      d = DiagonalMatrix[1, 2, 3]
+      assert_equal :diagonal, d.structure
+      assert_equal Matrix[[1, 0, 0], [0, 2, 0], [0, 0, 3]], d.to_matrix
+      assert_equal 2, d[1, 1]
+      assert_equal 0, d[0, 2]
+      assert_nil d[3, 0]
+      assert_equal 6, d.det
+    end
+
+    def test_triangular_from_dense
+      l = TriangularMatrix.from_dense(@dense)
+      u = TriangularMatrix.from_dense(@dense, :upper)
+      assert l.lower?
+      assert u.upper?
+      assert_equal Matrix[[4, 0, 0, 0], [2, 5, 0, 0], [0, 3, 6, 0], [0, 0, 1, 7]], l.to_matrix
+      assert_equal Matrix[[4, 1, 0, 0], [0, 5, 1, 0], [0, 0, 6, 2], [0, 0, 0, 7]], u.to_matrix
+      assert_equal u.to_matrix.transpose, u.transpose.to_matrix
+      assert u.transpose.lower?
+    end
+
+    def test_symmetric_from_dense
+      s = SymmetricMatrix.from_dense(@dense)
+      assert_equal 2, s[0, 1]
+      assert_equal 2, s[1, 0]
+      assert_equal s.to_matrix, s.to_matrix.transpose
+    end
+
+    def test_banded_from_dense
+      b = BandedMatrix.from_dense(@dense, 1, 1)
+      assert_equal [1, 1], b.bandwidth
+      assert_equal @dense, b.to_matrix
+      assert_equal @dense.transpose, b.transpose.to_matrix
+    end
+
+    def test_tridiagonal
+      t = BandedMatrix.tridiagonal([2, 3, 1], [4, 5, 6, 7], [1, 1, 2])
+      assert_equal @dense, t.to_matrix
+    end
+
+    def test_multiply_vector
+      [DiagonalMatrix.from_dense(@dense), TriangularMatrix.from_dense(@dense),
+       TriangularMatrix.from_dense(@dense, :upper), SymmetricMatrix.from_dense(@dense),
+       BandedMatrix.from_dense(@dense, 1, 2)].each do |s|
+        assert_equal s.to_matrix * @vector, s * @vector
+      end
+    end
+
+    def test_multiply_matrix
+      other = Matrix[[1, 2], [3, 4], [5, 6], [7, 8]]
+      b = BandedMatrix.from_dense(@dense, 1, 1)
+      assert_equal @dense * other, b * other
+      assert_equal other.transpose * @dense, other.transpose * b
+      assert_equal @dense * 2, (b * 2).to_matrix
+    end
+
+    def test_solve
+      [DiagonalMatrix.from_dense(@dense), TriangularMatrix.from_dense(@dense),
+       TriangularMatrix.from_dense(@dense, :upper), SymmetricMatrix.from_dense(@dense),
+       BandedMatrix.from_dense(@dense, 1, 1), BandedMatrix.from_dense(@dense, 1, 2)].each do |s|
+        x = s.solve(s * @vector)
+        4.times { |i| assert_in_delta @vector[i], x[i], 1e-9 }
+      end
+    end
+
+    def test_solve_matrix
+      b = BandedMatrix.from_dense(@dense, 1, 1)
+      other = Matrix[[1, 2], [3, 4], [5, 6], [7, 8]]
+      x = b.solve(@dense * other)
+      4.times { |i| 2.times { |j| assert_in_delta other[i, j], x[i, j], 1e-9 } }
+    end
+
+    def test_solve_zero_pivot
+      assert_equal Vector[2, 1], BandedMatrix.tridiagonal([1], [0, 0], [1]).solve(Vector[1, 2])
+      banded = BandedMatrix.from_dense(Matrix[[0, 1, 2], [1, 0, 1], [3, 1, 0]], 2, 2)
+      x = banded.solve(Vector[3, 2, 4])
+      3.times { |i| assert_in_delta 1, x[i], 1e-9 }
+    end
+
+    def test_solve_singular
+      assert_raises(FastMatrix::IndexError) { DiagonalMatrix[1, 0].solve(Vector[1, 1]) }
+    end
+
+    def test_determinant
+      assert_in_delta @dense.determinant, BandedMatrix.from_dense(@dense, 1, 1).det, 1e-9
+      l = TriangularMatrix.from_dense(@dense)
+      assert_in_delta 840, l.det, 1e-9
+    end
+  end
+end
@@ -293,5 +293,16 @@ module FastVectorTest
       v2 = Vector[0.5, 1, 2]
       assert_equal v2, v1/2
     end
+
+    def test_outer
+      u = Vector[1, 2, 3]
+      v = Vector[4, -5]
+      assert_equal Matrix[[4, -5], [8, -10], [12, -15]], u.outer(v)
+      assert_equal u.to_matrix * v.covector, u.outer(v)
+    end
+
+    def test_outer_error
+      assert_raises(FastMatrix::TypeError) { Vector[1, 2].outer(Matrix[[1, 2]]) }
+    end
   end
 end
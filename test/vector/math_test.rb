@@ -0,0 +1,34 @@
+require 'test_helper'
+
+module FastVectorTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class MathTest < Minitest::Test
+    include FastMatrix
+
+    def test_functions
+      v = Vector[0, 4]
+      assert_equal Vector[1, Math.exp(4)], v.exp
+      assert_equal Vector[0, 2], v.sqrt
+      assert_equal Vector[0.5, 1 / (1 + Math.exp(-4))], v.sigmoid
+      assert_equal Vector[0, 64], v.pow(3)
+      assert_equal Vector[1, 3], v.clamp(1, 3)
+    end
+
+    def test_bang
+      v = Vector[1, 9]
+      v.sqrt!
+      assert_equal Vector[1, 3], v
+    end
+
+    def test_out
+      v = Vector[-1, 2]
+      out = Vector[0, 0]
+      v.pow(2, out: out)
+      assert_equal Vector[1, 4], out
+    end
+
+    def test_out_wrong_size
+      assert_raises(IndexError) { Vector[1, 2].exp(out: Vector[1]) }
+    end
+  end
+end
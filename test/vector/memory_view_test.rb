@@ -0,0 +1,64 @@
+require 'test_helper'
+require 'fiddle'
+
+module FastVectorTest
+  class VectorMemoryViewTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      skip 'Memory view is not supported' unless Vector.respond_to?(:from_memory_view)
+    end
+
+    def test_export
+      v = Vector[1, 2, 3]
+      view = Fiddle::MemoryView.new(v)
+      assert_equal [3], view.shape
+      assert_equal 3.0, view[2]
+      view.release
+    end
+
+    def test_from_memory_view
+      m = Matrix[[1, 2], [3, 4]]
+      assert_equal Vector[1, 2, 3, 4], Vector.from_memory_view(m)
+    end
+
+    def test_from_string
+      assert_equal Vector[1, 2, 3], Vector.from_memory_view([1, 2, 3].pack('d*'))
+    end
+
+    def test_wrap_memory_view
+      v = Vector[1, 2, 3]
+      w = Vector.wrap_memory_view(v)
+      w[1] = 5
+      assert_equal Vector[1, 5, 3], v
+    end
+
+    def test_wrap_clone
+      v = Vector[1, 2, 3]
+      w = Vector.wrap_memory_view(v)
+      c = w.clone
+      w[1] = 5
+      assert_equal Vector[1, 5, 3], v
+      assert_equal Vector[1, 2, 3], c
+    end
+
+    def test_wrap_readonly_clone
+      v = Vector[1, 2, 3].freeze
+      clone = Vector.wrap_memory_view(v).clone
+      GC.start
+      clone[0] = 5
+      assert_equal Vector[5, 2, 3], clone
+      assert_equal Vector[1, 2, 3], v
+    end
+
+    def test_clone_of_exported
+      v = Vector[1, 2, 3]
+      view = Fiddle::MemoryView.new(v)
+      c = v.clone
+      v[0] = 7
+      assert_equal 7.0, view[0]
+      assert_equal Vector[1, 2, 3], c
+      view.release
+    end
+  end
+end
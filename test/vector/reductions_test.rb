@@ -0,0 +1,42 @@
+require 'test_helper'
+
+module FastVectorTest
+  # noinspection RubyInstanceMethodNamingConvention
+  class ReductionsTest < Minitest::Test
+    include FastMatrix
+
+    def setup
+      @v = Vector[2, -8, 3, 7]
+    end
+
+    def test_sum
+      assert_equal 4, @v.sum
+      assert_equal 4, @v.sum(:kahan)
+    end
+
+    def test_mean
+      assert_equal 1, @v.mean
+    end
+
+    def test_min_max
+      assert_equal(-8, @v.min)
+      assert_equal 7, @v.max
+    end
+
+    def test_argmin_argmax
+      assert_equal 1, @v.argmin
+      assert_equal 3, @v.argmax
+    end
+
+    def test_norm
+      assert_in_delta Math.sqrt(126), @v.norm
+      assert_in_delta Math.sqrt(126), @v.norm(2)
+      assert_equal 20, @v.norm(1)
+      assert_equal 8, @v.norm(:inf)
+    end
+
+    def test_norm_unknown
+      assert_raises(TypeError) { @v.norm(:fro) }
+    end
+  end
+end
@@ -0,0 +1,28 @@
+require 'test_helper'
+require 'tmpdir'
+
+module FastVectorTest
+  class VectorSerializationTest < Minitest::Test
+    include FastMatrix
+
+    def test_binary
+      v = Vector[1, -2.5, 3]
+      assert_equal v, Vector.from_binary(v.to_binary)
+    end
+
+    def test_marshal
+      v = Vector[1, 2, 3]
+      assert_equal v, Marshal.load(Marshal.dump(v))
+    end
+
+    def test_npy
+      v = Vector[1, 2, 3, 4]
+      Dir.mktmpdir do |dir|
+        path = File.join(dir, 'v.npy')
+        v.save_npy(path)
+        assert_equal v, Vector.load_npy(path)
+        assert_equal Matrix[[1, 2, 3, 4]], Matrix.load_npy(path)
+      end
+    end
+  end
+end
@@ -12,6 +12,16 @@ module FastVectorTest
       refute_same original, clone
     end
 
+    def test_clone_modify
+      original = Vector[1, 2, 3]
+      clone = original.clone
+      clone[0] = 5
+      original.sub!(Vector[1, 1, 1])
+
+      assert_equal Vector[0, 1, 2], original
+      assert_equal Vector[5, 2, 3], clone
+    end
+
     def test_same
       v = Vector[1, 2]
       assert_same v, v
@@ -119,6 +129,22 @@ module FastVectorTest
       assert_equal [1, 2, 3, 4], vector.each.to_a
     end
 
+    def test_each_with_index
+      vector = Vector[1, 2]
+      assert_equal [[1, 0], [2, 1]], vector.each_with_index.to_a
+    end
+
+    def test_each_with_index_self
+      vector = Vector[1, 2]
+      vector.each_with_index! { |e, i| e * 10 + i }
+      assert_equal Vector[10, 21], vector
+    end
+
+    def test_to_ary
+      first, second = Vector[1, 2]
+      assert_equal [1, 2], [first, second]
+    end
+
     def test_freeze_index
       v = Vector[1, 2, 3, 4]
       v.freeze